@@ -0,0 +1,69 @@
+
+// grindtrick import boost_filesystem
+// grindtrick import boost_system
+
+/*
+Times nfc() and fold_case() on note names, against a plain copy of the
+same names: the ASCII names should cost about the copy.
+*/
+
+#include "notes_tool.hpp"
+
+#include <chrono>
+
+// Average nanoseconds of f over the names, run many times.
+template <typename Function>
+double time_per_name(vector<wstring> const & names, Function f)
+{
+    int const runs = 200;
+    std::size_t sink = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    for(int i = 0; i != runs; ++i)
+    {
+        for(auto const & name: names) sink += f(name).size();
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    // Keeps the calls from being optimized away.
+    if( sink == 1 ) wcout << "";
+
+    return std::chrono::duration<double, std::nano>(end - start).count() /
+        (runs * names.size());
+}
+
+vector<wstring> names_like(wstring const & subject)
+{
+    vector<wstring> r;
+    for(int i = 0; i != 10000; ++i)
+    {
+        r.push_back(L"sp" + std::to_wstring(i % 7) + L" pr" +
+            std::to_wstring(i % 31) + L' ' + subject + std::to_wstring(i));
+    }
+    return r;
+}
+
+int main()
+{
+    setlocale(LC_ALL, "");
+
+    std::pair<char const *, vector<wstring> > cases[] = {
+        { "ascii",      names_like(L"Notes de la semaine ") },
+        { "composed",   names_like(L"Arr\u00EAt du projet ") },
+        { "decomposed", names_like(L"Arre\u0302t du projet ") },
+    };
+
+    wcout << "ns per name      copy       nfc fold_case\n";
+
+    for(auto const & c: cases)
+    {
+        wcout << std::setw(10) << std::left << c.first << std::right << std::fixed;
+        wcout << std::setprecision(1);
+        wcout << std::setw(10) << time_per_name(c.second, [](wstring const & w) { return wstring(w); });
+        wcout << std::setw(10) << time_per_name(c.second, [](wstring const & w) { return nfc(w); });
+        wcout << std::setw(10) << time_per_name(c.second, [](wstring const & w) { return fold_case(w); });
+        wcout << '\n';
+    }
+
+    return 0;
+}
@@ -0,0 +1,8251 @@
+/*
+The notes engine: parsing, checks, repairs, indexes and the commands.
+Both notes_tool.cpp and notes_tool_tests.cpp are built from it, as a
+single translation unit each.
+*/
+#ifndef NOTES_TOOL_HPP
+#define NOTES_TOOL_HPP
+
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <iostream>
+#include <iomanip>
+#include <functional>
+#include <map>
+#include <vector>
+#include <set>
+#include <sstream>
+#include <string_view>
+#include <fstream>
+#include <unordered_map>
+#include <unordered_set>
+#include <regex>
+#include <deque>
+#include <condition_variable>
+#include <memory>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+
+#include <boost/algorithm/string.hpp>
+#include <boost/algorithm/string/case_conv.hpp>
+#include <boost/algorithm/string/replace.hpp>
+#include <boost/filesystem.hpp>
+#include <boost/optional.hpp>
+#include <boost/optional/optional_io.hpp>
+#include <boost/range/algorithm/count.hpp>
+#include <boost/range/algorithm/count_if.hpp>
+
+#include <climits>
+#include <csignal>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <cwchar>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#ifdef __linux__
+#include <sys/inotify.h>
+#include <sys/syscall.h>
+#if __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#define NOTES_TOOL_IO_URING 1
+#endif
+#endif
+
+#include "unicode_tables.hpp"
+
+
+
+template <typename T>
+using optional = boost::optional<T>;
+
+typedef std::wstring wstring;
+
+template <typename T>
+using vector = std::vector<T>;
+
+template <typename Key, typename Value>
+using map = std::map<Key, Value>;
+
+template <typename T>
+using set = std::set<T>;
+
+using std::wcout;
+using std::wcin ;
+using std::wcerr;
+
+typedef boost::filesystem::path path;
+
+wstring const SUBJECT_FIELD_NAME(L"Sujet");
+wstring const TAG_FIELD_NAME(L"\u00C9tiquettes");
+
+// Unix domain socket of "notes_tool serve", in the notes directory.
+char const SERVER_SOCKET_NAME[] = ".notes_tool.sock";
+
+// Written by "notes_tool snapshot", in the notes directory.
+char const SNAPSHOT_NAME[] = ".notes_snapshot";
+
+// Notes found clean by "check" and "repair", in the notes directory.
+char const CLEAN_STORE_NAME[] = ".notes_clean";
+
+/////////////////////////////////////////////////////////////////////////////
+
+/*
+The .notesignore rules, compiled once.
+
+By default, each line is a regular expression that must match a 
+whole file or directory name.  After a "syntax: glob" line, lines
+are gitignore-like globs, until a "syntax: regexp" line:
+
+    *.bak       any name, "*" and "?" do not match "/"
+    exports/    a trailing "/" matches directories only
+    /site/old   a leading or inner "/" anchors to the notes root
+    **.tmp      "**" also matches "/"
+    !keep.bak   "!" un-ignores; the last matching rule wins
+
+In glob mode, empty lines and lines starting with "#" are ignored.
+*/
+class IgnoreRules
+{
+public:
+    void add_regex(wstring const & re)
+    {
+        Rule rule;
+        rule.regex = std::wregex(re, std::regex::optimize);
+        rules_.push_back(rule);
+    }
+
+    void add_glob(wstring glob)
+    {
+        Rule rule;
+
+        if( !glob.empty() && glob.front() == L'!' )
+        {
+            rule.negate = true;
+            glob.erase(0, 1);
+        }
+
+        if( !glob.empty() && glob.back() == L'/' )
+        {
+            rule.directory_only = true;
+            glob.pop_back();
+        }
+
+        if( glob.find(L'/') != wstring::npos )
+        {
+            rule.anchored = true;
+            if( glob.front() == L'/' ) glob.erase(0, 1);
+        }
+
+        if( glob.empty() ) return;
+
+        if( glob.find_first_of(L"*?[\\") == wstring::npos )
+        {
+            rule.literal = glob;
+        }
+        else
+        {
+            rule.regex = std::wregex(regex_from_glob(glob), std::regex::optimize);
+        }
+
+        rules_.push_back(rule);
+    }
+
+    // The path is relative to the notes root, with "/" separators.
+    bool ignored(wstring const & relative, bool is_directory) const
+    {
+        auto slash = relative.rfind(L'/');
+        wstring name = slash == wstring::npos ? relative : relative.substr(slash + 1);
+
+        bool r = false;
+
+        for(auto const & rule: rules_)
+        {
+            if( rule.directory_only && !is_directory ) continue;
+            if( r != rule.negate ) continue; // would not change anything
+
+            wstring const & subject = rule.anchored ? relative : name;
+
+            bool match = rule.literal ? 
+                subject == *rule.literal : 
+                std::regex_match(subject, rule.regex);
+
+            if( match ) r = !rule.negate;
+        }
+
+        return r;
+    }
+
+    static wstring regex_from_glob(wstring const & glob)
+    {
+        wstring re;
+
+        for(std::size_t i = 0; i < glob.size(); ++i)
+        {
+            wchar_t c = glob[i];
+
+            if( c == L'*' )
+            {
+                if( i + 1 < glob.size() && glob[i + 1] == L'*' )
+                {
+                    ++i;
+                    if( i + 1 < glob.size() && glob[i + 1] == L'/' )
+                    {
+                        ++i;
+                        re += L"(.*/)?";
+                    }
+                    else
+                    {
+                        re += L".*";
+                    }
+                }
+                else
+                {
+                    re += L"[^/]*";
+                }
+            }
+            else if( c == L'?' )
+            {
+                re += L"[^/]";
+            }
+            else if( c == L'[' && glob.find(L']', i + 2) != wstring::npos )
+            {
+                std::size_t close = glob.find(L']', i + 2);
+                wstring set = glob.substr(i + 1, close - i - 1);
+                if( set.front() == L'!' ) set.front() = L'^';
+                re += L'[' + set + L']';
+                i = close;
+            }
+            else
+            {
+                if( c == L'\\' && i + 1 < glob.size() ) c = glob[++i];
+                if( wstring(L".^$|()[]{}*+?\\").find(c) != wstring::npos ) re += L'\\';
+                re += c;
+            }
+        }
+
+        return re;
+    }
+
+private:
+    struct Rule
+    {
+        optional<wstring> literal;
+        std::wregex regex;
+        bool anchored = false;
+        bool directory_only = false;
+        bool negate = false;
+    };
+
+    vector<Rule> rules_;
+};
+
+
+wstring string_from_path(path const & p)
+{
+    std::wstringstream ss;
+    ss << p;
+    return ss.str();
+}
+
+// Conversions between wide strings and the multibyte encoding
+// of the locale, used on the server socket.
+std::string narrow(wstring const & w)
+{
+    std::string r;
+    std::mbstate_t state{};
+    char buf[MB_LEN_MAX];
+
+    for(wchar_t c: w)
+    {
+        std::size_t n = std::wcrtomb(buf, c, &state);
+        if( n == static_cast<std::size_t>(-1) )
+        {
+            r += '?';
+            state = std::mbstate_t{};
+        }
+        else
+        {
+            r.append(buf, n);
+        }
+    }
+
+    return r;
+}
+
+wstring widen(std::string_view s)
+{
+    wstring r;
+    std::mbstate_t state{};
+
+    char const * p = s.data();
+    char const * end = p + s.size();
+
+    while( p != end )
+    {
+        wchar_t c;
+        std::size_t n = std::mbrtowc(&c, p, end - p, &state);
+
+        if( n == static_cast<std::size_t>(-1) ||
+            n == static_cast<std::size_t>(-2) )
+        {
+            c = L'?';
+            n = 1;
+            state = std::mbstate_t{};
+        }
+        else if( n == 0 )
+        {
+            n = 1;
+        }
+
+        r += c;
+        p += n;
+    }
+
+    return r;
+}
+
+
+/*
+Unicode normalization form C and simple case folding, from the 
+compact tables of unicode_tables.hpp: the Basic Multilingual Plane, 
+without Hangul.  Text with no character from U+0300 on, all ASCII 
+names and tags for a start, is already in form C and skips the tables.
+*/
+int combining_class(wchar_t c)
+{
+    if( c < 0x300 || c > 0xFFFF ) return 0;
+
+    auto const & t = UNICODE_COMBINING_CLASSES;
+    auto it = std::upper_bound(std::begin(t), std::end(t), c, 
+        [](wchar_t c, uint16_t const (&r)[3]) { return c < r[0]; });
+
+    if( it == std::begin(t) || c > (*--it)[1] ) return 0;
+    return (*it)[2];
+}
+
+// Appends the full canonical decomposition of c: the singletons and
+// the characters never composed again included.
+void decompose(wchar_t c, wstring & out)
+{
+    if( c < 0xC0 || c > 0xFFFF )
+    {
+        out += c;
+        return;
+    }
+
+    auto const & t = UNICODE_DECOMPOSITIONS;
+    auto it = std::lower_bound(std::begin(t), std::end(t), c, 
+        [](uint32_t const (&r)[3], wchar_t c) { return r[0] < uint32_t(c); });
+
+    if( it == std::end(t) || (*it)[0] != uint32_t(c) )
+    {
+        out += c;
+        return;
+    }
+
+    decompose((*it)[1], out);
+    if( (*it)[2] ) decompose((*it)[2], out);
+}
+
+// The composite of two characters, or 0.
+wchar_t compose(wchar_t first, wchar_t second)
+{
+    // Sorted by first and second, built once.
+    static vector<uint16_t> const by_pair = []()
+    {
+        vector<uint16_t> r(std::size(UNICODE_COMPOSITIONS));
+        for(std::size_t i = 0; i != r.size(); ++i) r[i] = i;
+
+        std::sort(r.begin(), r.end(), [](uint16_t a, uint16_t b)
+        {
+            auto const & x = UNICODE_COMPOSITIONS[a];
+            auto const & y = UNICODE_COMPOSITIONS[b];
+            return std::make_pair(x[0], x[1]) < std::make_pair(y[0], y[1]);
+        });
+        return r;
+    }();
+
+    if( second < 0x300 || first > 0xFFFF || second > 0xFFFF ) return 0;
+
+    auto key = std::make_pair(uint16_t(first), uint16_t(second));
+    auto it = std::lower_bound(by_pair.begin(), by_pair.end(), key, 
+        [](uint16_t i, std::pair<uint16_t, uint16_t> const & key)
+        {
+            auto const & x = UNICODE_COMPOSITIONS[i];
+            return std::make_pair(x[0], x[1]) < key;
+        });
+
+    if( it == by_pair.end() ) return 0;
+
+    auto const & x = UNICODE_COMPOSITIONS[*it];
+    return std::make_pair(x[0], x[1]) == key ? x[2] : 0;
+}
+
+// In normalization form C: "e" and U+0301 become "é".
+wstring nfc(wstring const & w)
+{
+    if( std::all_of(w.begin(), w.end(), [](wchar_t c) { return c < 0x300; }) ) 
+        return w;
+
+    wstring d;
+    for(wchar_t c: w) decompose(c, d);
+
+    // Canonical order: combining marks sorted by class, stable.
+    for(std::size_t i = 1; i < d.size(); ++i)
+    {
+        int k = combining_class(d[i]);
+        for(std::size_t j = i; k && j > 0 && combining_class(d[j - 1]) > k; --j)
+        {
+            std::swap(d[j - 1], d[j]);
+        }
+    }
+
+    // Compose each mark with the last starter, unless a mark of the 
+    // same class or a starter comes in between.
+    wstring r;
+    std::size_t starter = wstring::npos;
+    int last_class = -1;
+
+    for(wchar_t c: d)
+    {
+        int k = combining_class(c);
+
+        if( starter != wstring::npos && (last_class < k || last_class == 0) )
+        {
+            if( wchar_t composite = compose(r[starter], c) )
+            {
+                r[starter] = composite;
+                continue;
+            }
+        }
+
+        if( k == 0 ) starter = r.size();
+        last_class = k;
+        r += c;
+    }
+
+    return r;
+}
+
+wchar_t fold_case(wchar_t c)
+{
+    if( c < 0x80 ) return (c >= L'A' && c <= L'Z') ? c + (L'a' - L'A') : c;
+
+    auto const & t = UNICODE_CASE_FOLDS;
+    auto it = std::upper_bound(std::begin(t), std::end(t), c, 
+        [](wchar_t c, int32_t const (&r)[4]) { return c < r[0]; });
+
+    if( it == std::begin(t) ) return c;
+    --it;
+
+    if( c > (*it)[1] || (c - (*it)[0]) % (*it)[3] ) return c;
+    return c + (*it)[2];
+}
+
+// Case folded: compares equal whatever the case.
+wstring fold_case(wstring w)
+{
+    for(auto & c: w)
+    {
+        if( c >= 0x80 ) c = fold_case(c);
+        else if( c >= L'A' && c <= L'Z' ) c += L'a' - L'A';
+    }
+    return w;
+}
+
+// Lower case without accents, for matching what users type.
+wstring fold(wstring const & w)
+{
+    // Latin-1 Supplement and Latin Extended-A letters, "." keeps
+    // the character as is.
+    static char const latin[] = 
+        "aaaaaaaceeeeiiiidnooooo.ouuuuyts"  // U+00C0
+        "aaaaaaaceeeeiiiidnooooo.ouuuuyty"  // U+00E0
+        "aaaaaaccccccccddddeeeeeeeeeegggg"  // U+0100
+        "gggghhhhiiiiiiiiiiiijjkkklllllll"  // U+0120
+        "lllnnnnnnnnnoooooooorrrrrrssssss"  // U+0140
+        "ssttttttuuuuuuuuuuuuwwyyyzzzzzzs"; // U+0160
+
+    wstring r;
+    r.reserve(w.size());
+
+    for(wchar_t c: w)
+    {
+        if( c < 0x80 )
+        {
+            r += (c >= L'A' && c <= L'Z') ? c + (L'a' - L'A') : c;
+        }
+        else if( c >= 0xC0 && c < 0x180 && latin[c - 0xC0] != '.' )
+        {
+            r += wchar_t(latin[c - 0xC0]);
+        }
+        else if( c >= 0x300 && c < 0x370 )
+        {
+            // Combining accent, as in decomposed text: dropped.
+        }
+        else
+        {
+            r += fold_case(c);
+        }
+    }
+
+    return r;
+}
+
+// Locale independent, for what is stored in files.
+std::string utf8_from_wide(wstring const & w)
+{
+    std::string r;
+    r.reserve(w.size());
+
+    for(wchar_t wc: w)
+    {
+        uint32_t c = static_cast<uint32_t>(wc);
+
+        if( c < 0x80 )
+        {
+            r += static_cast<char>(c);
+        }
+        else if( c < 0x800 )
+        {
+            r += static_cast<char>(0xC0 | (c >> 6));
+            r += static_cast<char>(0x80 | (c & 0x3F));
+        }
+        else if( c < 0x10000 )
+        {
+            r += static_cast<char>(0xE0 | (c >> 12));
+            r += static_cast<char>(0x80 | ((c >> 6) & 0x3F));
+            r += static_cast<char>(0x80 | (c & 0x3F));
+        }
+        else
+        {
+            r += static_cast<char>(0xF0 | (c >> 18));
+            r += static_cast<char>(0x80 | ((c >> 12) & 0x3F));
+            r += static_cast<char>(0x80 | ((c >> 6) & 0x3F));
+            r += static_cast<char>(0x80 | (c & 0x3F));
+        }
+    }
+
+    return r;
+}
+
+wstring wide_from_utf8(char const * p, std::size_t size)
+{
+    wstring r;
+    r.reserve(size);
+
+    unsigned char const * s = reinterpret_cast<unsigned char const *>(p);
+    unsigned char const * end = s + size;
+
+    while( s != end )
+    {
+        uint32_t c = *s++;
+        int more = 0;
+
+        if     ( c >= 0xF0 ) { c &= 0x07; more = 3; }
+        else if( c >= 0xE0 ) { c &= 0x0F; more = 2; }
+        else if( c >= 0xC0 ) { c &= 0x1F; more = 1; }
+
+        for(; more && s != end; --more)
+        {
+            c = (c << 6) | (*s++ & 0x3F);
+        }
+
+        r += static_cast<wchar_t>(c);
+    }
+
+    return r;
+}
+
+wstring wide_from_utf8(std::string const & s)
+{
+    return wide_from_utf8(s.data(), s.size());
+}
+
+// Modification time in nanoseconds, zero if the file does not exist.
+int64_t mtime_of(path const & p, uint64_t * size = nullptr)
+{
+    struct stat st;
+    if( stat(p.string().c_str(), &st) != 0 )
+    {
+        if( size ) *size = 0;
+        return 0;
+    }
+
+    if( size ) *size = static_cast<uint64_t>(st.st_size);
+
+    return int64_t{st.st_mtim.tv_sec} * 1000000000 + st.st_mtim.tv_nsec;
+}
+
+// XXH64, from the xxHash specification.
+uint64_t xxhash64(char const * p, std::size_t size, uint64_t seed = 0)
+{
+    uint64_t const P1 = 11400714785074694791ull;
+    uint64_t const P2 = 14029467366897019727ull;
+    uint64_t const P3 =  1609587929392839161ull;
+    uint64_t const P4 =  9650029242287828579ull;
+    uint64_t const P5 =  2870177450012600261ull;
+
+    auto rotl  = [](uint64_t x, int r) { return (x << r) | (x >> (64 - r)); };
+    auto read64 = [](char const * q) { uint64_t v; std::memcpy(&v, q, 8); return v; };
+    auto read32 = [](char const * q) { uint32_t v; std::memcpy(&v, q, 4); return uint64_t{v}; };
+    auto round = [&](uint64_t acc, uint64_t input)
+    {
+        return rotl(acc + input * P2, 31) * P1;
+    };
+    auto merge = [&](uint64_t acc, uint64_t v)
+    {
+        return (acc ^ round(0, v)) * P1 + P4;
+    };
+
+    char const * end = p + size;
+    uint64_t h;
+
+    if( size >= 32 )
+    {
+        uint64_t v1 = seed + P1 + P2;
+        uint64_t v2 = seed + P2;
+        uint64_t v3 = seed;
+        uint64_t v4 = seed - P1;
+
+        for(; p + 32 <= end; p += 32)
+        {
+            v1 = round(v1, read64(p));
+            v2 = round(v2, read64(p + 8));
+            v3 = round(v3, read64(p + 16));
+            v4 = round(v4, read64(p + 24));
+        }
+
+        h = rotl(v1, 1) + rotl(v2, 7) + rotl(v3, 12) + rotl(v4, 18);
+        h = merge(h, v1);
+        h = merge(h, v2);
+        h = merge(h, v3);
+        h = merge(h, v4);
+    }
+    else
+    {
+        h = seed + P5;
+    }
+
+    h += size;
+
+    for(; p + 8 <= end; p += 8)
+    {
+        h = rotl(h ^ round(0, read64(p)), 27) * P1 + P4;
+    }
+
+    if( p + 4 <= end )
+    {
+        h = rotl(h ^ (read32(p) * P1), 23) * P2 + P3;
+        p += 4;
+    }
+
+    for(; p != end; ++p)
+    {
+        h = rotl(h ^ (static_cast<unsigned char>(*p) * P5), 11) * P1;
+    }
+
+    h ^= h >> 33;
+    h *= P2;
+    h ^= h >> 29;
+    h *= P3;
+    h ^= h >> 32;
+
+    return h;
+}
+
+uint64_t xxhash64(std::string const & s, uint64_t seed = 0)
+{
+    return xxhash64(s.data(), s.size(), seed);
+}
+
+/*
+Calls f(i) for every i in [0, n), on as many threads as there are
+processors.  The first exception thrown by f is rethrown once all
+threads are done.  If a thread cannot start, the threads started stop
+after their current i and are joined, then the error is rethrown.
+*/
+template <typename Function>
+void parallel_for(std::size_t n, Function f)
+{
+    std::size_t threads = std::max(1u, std::thread::hardware_concurrency());
+    threads = std::min(threads, n);
+
+    std::atomic<std::size_t> next{0};
+    std::exception_ptr error;
+    std::mutex error_mutex;
+
+    auto work = [&]()
+    {
+        for(std::size_t i; (i = next++) < n; )
+        {
+            try
+            {
+                f(i);
+            }
+            catch(...)
+            {
+                std::lock_guard<std::mutex> lock(error_mutex);
+                if( !error ) error = std::current_exception();
+                next = n;
+            }
+        }
+    };
+
+    vector<std::thread> pool;
+    try
+    {
+        for(std::size_t t = 1; t < threads; ++t) pool.emplace_back(work);
+    }
+    catch(...)
+    {
+        next = n;
+        for(auto & t: pool) t.join();
+        throw;
+    }
+
+    work();
+    for(auto & t: pool) t.join();
+
+    if( error ) std::rethrow_exception(error);
+}
+
+// As a JSON string literal, UTF-8 encoded.
+std::string json_string(wstring const & w)
+{
+    std::string r("\"");
+
+    for(char c: utf8_from_wide(w))
+    {
+        switch( c )
+        {
+        case '"':  r += "\\\""; break;
+        case '\\': r += "\\\\"; break;
+        case '\n': r += "\\n";  break;
+        case '\r': r += "\\r";  break;
+        case '\t': r += "\\t";  break;
+        default:
+            if( static_cast<unsigned char>(c) < 0x20 )
+            {
+                char buf[8];
+                std::snprintf(buf, sizeof(buf), "\\u%04x", c);
+                r += buf;
+            }
+            else
+            {
+                r += c;
+            }
+        }
+    }
+
+    r += '"';
+    return r;
+}
+
+std::string json_string(optional<wstring> const & w)
+{
+    return w ? json_string(*w) : "null";
+}
+
+uint64_t fnv1a(char const * p, std::size_t size, 
+    uint64_t hash = 14695981039346656037ull)
+{
+    for(std::size_t i = 0; i != size; ++i)
+    {
+        hash ^= static_cast<unsigned char>(p[i]);
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+
+/*
+Normally would derive from std::ios_base::failure
+but it is uncatchable!  The reason is that the
+standard library throws failure for the older
+ABI and my code wants to catch failure for the
+newer ABI (or vice versa).
+
+There was an ABI change to failure because it
+is now derived from std::system instead of 
+std::runtime_error.
+
+There are two failure class types in the system,
+one for each ABI.
+
+We will work with std::system_error instead.
+
+https://gcc.gnu.org/bugzilla/show_bug.cgi?id=66145
+
+GCC bug # 66145.
+*/
+class IOStreamError : public std::system_error
+{
+    typedef std::system_error BaseType;
+
+public:
+
+    IOStreamError(path const & file_resource, 
+        BaseType const & error)
+    :
+        BaseType(error),
+        resource_( string_from_path(file_resource) )
+    {
+        what_ = "on file \"" + file_resource.string();
+        what_ += "\", error \"";
+        what_ += BaseType::what();
+        what_ += "\"";
+    }
+
+    wstring const resource_;
+
+    virtual const char * what() const noexcept
+    {
+        return what_.c_str();
+    }
+
+private:
+    std::string what_;
+};
+
+
+// Reads a whole file, returns 0 or the errno value.
+int read_file(path const & file, std::string & bytes)
+{
+    bytes.clear();
+
+    int fd = ::open(file.string().c_str(), O_RDONLY | O_CLOEXEC);
+    if( fd == -1 ) return errno;
+
+    struct stat st;
+    if( fstat(fd, &st) == 0 ) bytes.reserve(st.st_size);
+
+    char buf[64 * 1024];
+    for(;;)
+    {
+        ssize_t n = read(fd, buf, sizeof(buf));
+        if( n < 0 )
+        {
+            int err = errno;
+            close(fd);
+            return err;
+        }
+        if( n == 0 ) break;
+        bytes.append(buf, n);
+    }
+
+    close(fd);
+    return 0;
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+
+bool is_input(wstring const & t, wstring const & test_for)
+{
+    wstring lo = fold_case(t);
+    return lo == test_for || lo == wstring(1, test_for.front());
+}
+
+bool is_yes(wstring const & t)
+{
+    return is_input(t, L"yes");
+}
+
+bool is_all(wstring const & t)
+{
+    return is_input(t, L"all");
+}
+
+bool is_file_all_repairs(wstring const & t)
+{
+    return is_input(t, L"file");
+}
+
+bool is_file_skip(wstring const & t)
+{
+    return is_input(t, L"skip");
+}
+
+bool is_quit(wstring const & t)
+{
+    return is_input(t, L"quit");
+}
+
+/////////////////////////////////////////////////////////////////////////////
+
+// What an annex directory holds, gathered when it is listed.
+class AnnexStats
+{
+public:
+    std::size_t entries = 0;    // files and directories, at any depth
+    uintmax_t size = 0;         // of the files
+    std::time_t newest = 0;     // modification time of the newest file
+};
+
+/*
+Where the notes of a root are: a directory, a tar archive, memory.
+Paths are relative to the root, with "/" separators.  Scans and checks
+only go through the source, they run the same on all of them.
+*/
+class Source
+{
+public:
+    explicit Source(path const & root) : root_(root) {}
+    virtual ~Source() {}
+
+    path const & root() const
+    {
+        return root_;
+    }
+
+    /*
+    Calls f(name, is_directory) for the files and directories right
+    in the root, in the same order each time, until f returns false.
+    Returns false if f did.
+    */
+    virtual bool list(std::function<bool (wstring const &, bool)> const & f) const = 0;
+
+    // Adds what a directory holds, at any depth, except what the
+    // rules ignore.
+    virtual void list_annex(wstring const & relative, IgnoreRules const & rules,
+        AnnexStats & stats) const = 0;
+
+    virtual bool exists(wstring const & relative) const = 0;
+
+    /*
+    The content of a file: a view of the memory of the source when the
+    file is there, else of storage.  Returns 0 or an errno value.
+    */
+    virtual int read(wstring const & relative, std::string & storage, 
+        std::string_view & bytes) const = 0;
+
+    // The files are root / relative on the disk, they can be read
+    // by path.
+    virtual bool on_disk() const
+    {
+        return false;
+    }
+
+private:
+    path root_;
+};
+
+class DirectorySource : public Source
+{
+public:
+    explicit DirectorySource(path const & root) : Source(root) {}
+
+    virtual bool list(std::function<bool (wstring const &, bool)> const & f) const
+    {
+        for(auto x : boost::filesystem::directory_iterator(root()))
+        {
+            // The type usually comes with the entry: an ignored 
+            // directory costs no system call, it is never opened.
+            bool is_dir = is_directory(x);
+
+            if( !is_dir && !is_regular_file(x) ) continue;
+            if( !f(x.path().filename().wstring(), is_dir) ) return false;
+        }
+
+        return true;
+    }
+
+    virtual void list_annex(wstring const & relative, IgnoreRules const & rules,
+        AnnexStats & stats) const
+    {
+        list_directory(root() / relative, relative, rules, stats);
+    }
+
+    virtual bool exists(wstring const & relative) const
+    {
+        boost::system::error_code ec;
+        return boost::filesystem::exists(root() / relative, ec);
+    }
+
+    virtual int read(wstring const & relative, std::string & storage, 
+        std::string_view & bytes) const
+    {
+        int err = read_file(root() / relative, storage);
+        bytes = storage;
+        return err;
+    }
+
+    virtual bool on_disk() const
+    {
+        return true;
+    }
+
+private:
+    static void list_directory(path const & dir, wstring const & relative,
+        IgnoreRules const & rules, AnnexStats & stats)
+    {
+        boost::system::error_code ec;
+
+        for(boost::filesystem::directory_iterator it(dir, ec), end; 
+            !ec && it != end; it.increment(ec))
+        {
+            wstring rel = relative + L'/' + it->path().filename().wstring();
+            bool is_dir = is_directory(*it);
+
+            if( rules.ignored(rel, is_dir) ) continue;
+
+            ++stats.entries;
+
+            if( is_dir )
+            {
+                list_directory(it->path(), rel, rules, stats);
+            }
+            else
+            {
+                stats.size += file_size(it->path(), ec);
+                stats.newest = std::max(stats.newest, last_write_time(it->path(), ec));
+                ec.clear();
+            }
+        }
+    }
+};
+
+/*
+Files held in memory, for the tests and the benchmarks, and under the
+archive sources.  The directories above a file are implied.
+*/
+class MemorySource : public Source
+{
+public:
+    explicit MemorySource(path const & root = "memory") : Source(root) {}
+
+    MemorySource(MemorySource const &) = delete;
+    MemorySource & operator =(MemorySource const &) = delete;
+
+    void add_file(wstring const & relative, std::string content, std::time_t mtime = 0)
+    {
+        contents_.push_back( std::move(content) );
+        add_view(relative, contents_.back(), mtime);
+    }
+
+    void add_directory(wstring const & relative)
+    {
+        add_entry(relative, Entry{true, std::string_view(), 0});
+    }
+
+    virtual bool list(std::function<bool (wstring const &, bool)> const & f) const
+    {
+        for(auto const & e: entries_)
+        {
+            if( e.first.find(L'/') != wstring::npos ) continue;
+            if( !f(e.first, e.second.directory) ) return false;
+        }
+
+        return true;
+    }
+
+    virtual void list_annex(wstring const & relative, IgnoreRules const & rules,
+        AnnexStats & stats) const
+    {
+        wstring prefix = relative + L'/';
+
+        for(auto it = entries_.lower_bound(prefix); 
+            it != entries_.end() && boost::algorithm::starts_with(it->first, prefix); ++it)
+        {
+            wstring const & rel = it->first;
+            Entry const & e = it->second;
+
+            // Deeper entries are counted by their directory, unless ignored.
+            if( rel.find(L'/', prefix.size()) != wstring::npos ) continue;
+            if( rules.ignored(rel, e.directory) ) continue;
+
+            ++stats.entries;
+
+            if( e.directory )
+            {
+                list_annex(rel, rules, stats);
+            }
+            else
+            {
+                stats.size += e.content.size();
+                stats.newest = std::max(stats.newest, e.mtime);
+            }
+        }
+    }
+
+    virtual bool exists(wstring const & relative) const
+    {
+        return entries_.count(relative) != 0;
+    }
+
+    virtual int read(wstring const & relative, std::string &, 
+        std::string_view & bytes) const
+    {
+        auto e = entries_.find(relative);
+        if( e == entries_.end() ) return ENOENT;
+        if( e->second.directory ) return EISDIR;
+
+        bytes = e->second.content;
+        return 0;
+    }
+
+protected:
+    // The content is not copied: it must outlive the source.
+    void add_view(wstring const & relative, std::string_view content, std::time_t mtime)
+    {
+        add_entry(relative, Entry{false, content, mtime});
+    }
+
+private:
+    struct Entry
+    {
+        bool directory;
+        std::string_view content;
+        std::time_t mtime;
+    };
+
+    void add_entry(wstring const & relative, Entry const & entry)
+    {
+        for(std::size_t slash = relative.find(L'/'); slash != wstring::npos; 
+            slash = relative.find(L'/', slash + 1))
+        {
+            entries_.emplace(relative.substr(0, slash), Entry{true, std::string_view(), 0});
+        }
+
+        entries_[relative] = entry;
+    }
+
+    std::deque<std::string> contents_;  // a deque: the views stay valid
+    map<wstring, Entry> entries_;
+};
+
+/*
+A tar archive, mapped in memory: the notes are read where they are.
+Names can be ustar, GNU long names or pax paths; links and special
+files are left out.  When all the members are under one directory,
+as with "tar cf notes.tar notes/", that directory is the root.
+*/
+class TarSource : public MemorySource
+{
+public:
+    explicit TarSource(path const & file) : MemorySource(file)
+    {
+        int fd = ::open(file.string().c_str(), O_RDONLY | O_CLOEXEC);
+        if( fd == -1 ) fail(errno);
+
+        struct stat st;
+        if( fstat(fd, &st) != 0 )
+        {
+            int err = errno;
+            close(fd);
+            fail(err);
+        }
+
+        size_ = st.st_size;
+        if( size_ != 0 )
+        {
+            void * p = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+            if( p == MAP_FAILED )
+            {
+                int err = errno;
+                close(fd);
+                fail(err);
+            }
+
+            data_ = static_cast<char const *>(p);
+        }
+
+        close(fd);
+
+        try
+        {
+            parse();
+        }
+        catch(...)
+        {
+            if( data_ ) munmap(const_cast<char *>(data_), size_);
+            throw;
+        }
+    }
+
+    ~TarSource()
+    {
+        if( data_ ) munmap(const_cast<char *>(data_), size_);
+    }
+
+private:
+    struct Member
+    {
+        std::string name;
+        bool directory;
+        std::string_view content;
+        std::time_t mtime;
+    };
+
+    void parse()
+    {
+        vector<Member> members;
+        std::string long_name;  // of the next member
+        std::size_t at = 0;
+
+        for(; at + 512 <= size_; )
+        {
+            char const * h = data_ + at;
+            if( std::all_of(h, h + 512, [](char c) { return c == 0; }) ) break;
+
+            if( number(h + 148, 8) != checksum(h) ) invalid();
+
+            uint64_t size = number(h + 124, 12);
+            std::size_t begin = at + 512;
+            if( size > size_ - begin ) invalid();
+
+            std::string_view content(data_ + begin, size);
+            at = begin + (size + 511) / 512 * 512;
+
+            char type = h[156];
+
+            if( type == 'L' )
+            {
+                long_name.assign(content.data(), strnlen(content.data(), content.size()));
+                continue;
+            }
+
+            if( type == 'x' )
+            {
+                pax_path(content, long_name);
+                continue;
+            }
+
+            std::string name = long_name.empty() ? ustar_name(h) : long_name;
+            long_name.clear();
+
+            bool directory = type == '5';
+            bool file = type == '0' || type == '\0' || type == '7';
+            if( !directory && !file ) continue;
+
+            while( boost::algorithm::starts_with(name, "./") ) name.erase(0, 2);
+            while( !name.empty() && name.back() == '/' ) name.pop_back();
+            if( name.empty() || name == "." ) continue;
+
+            members.push_back( Member{name, directory, content, 
+                std::time_t(number(h + 136, 12))} );
+        }
+
+        // Neither the end blocks nor the end of the file: not a tar.
+        if( at + 512 > size_ && at != size_ ) invalid();
+
+        std::string top = members.empty() ? std::string() : 
+            members.front().name.substr(0, members.front().name.find('/'));
+
+        bool one_top = !top.empty();
+        for(auto const & m: members)
+        {
+            if( m.name == top ? !m.directory : !boost::algorithm::starts_with(m.name, top + '/') )
+            {
+                one_top = false;
+            }
+        }
+
+        for(auto const & m: members)
+        {
+            if( one_top && m.name == top ) continue;
+
+            wstring name = wide_from_utf8( one_top ? m.name.substr(top.size() + 1) : m.name );
+
+            if( m.directory ) add_directory(name);
+            else add_view(name, m.content, m.mtime);
+        }
+    }
+
+    // Octal, or base-256 when the first bit is set.
+    uint64_t number(char const * p, std::size_t size) const
+    {
+        uint64_t n = 0;
+
+        if( static_cast<unsigned char>(p[0]) & 0x80 )
+        {
+            n = static_cast<unsigned char>(p[0]) & 0x7F;
+            for(std::size_t i = 1; i != size; ++i) n = n << 8 | static_cast<unsigned char>(p[i]);
+            return n;
+        }
+
+        std::size_t i = 0;
+        while( i != size && (p[i] == ' ' || p[i] == '\0') ) ++i;
+        for(; i != size && p[i] >= '0' && p[i] <= '7'; ++i) n = n * 8 + (p[i] - '0');
+        return n;
+    }
+
+    // The bytes of the header, its checksum field taken as spaces.
+    static uint64_t checksum(char const * h)
+    {
+        uint64_t sum = 0;
+        for(int i = 0; i != 512; ++i)
+        {
+            sum += (i >= 148 && i < 156) ? ' ' : static_cast<unsigned char>(h[i]);
+        }
+        return sum;
+    }
+
+    static std::string ustar_name(char const * h)
+    {
+        std::string name(h, strnlen(h, 100));
+
+        if( std::memcmp(h + 257, "ustar", 5) == 0 && h[345] )
+        {
+            name = std::string(h + 345, strnlen(h + 345, 155)) + '/' + name;
+        }
+
+        return name;
+    }
+
+    // Records are "LENGTH key=value\n".
+    static void pax_path(std::string_view records, std::string & path_out)
+    {
+        while( !records.empty() )
+        {
+            std::size_t length = std::strtoul(records.data(), nullptr, 10);
+            if( length == 0 || length > records.size() ) return;
+
+            std::string_view record = records.substr(0, length - 1);
+            std::size_t key = record.find(' ');
+
+            if( key != std::string_view::npos && record.substr(key + 1, 5) == "path=" )
+            {
+                path_out = std::string(record.substr(key + 6));
+            }
+
+            records.remove_prefix(length);
+        }
+    }
+
+    [[noreturn]] void fail(int err) const
+    {
+        throw IOStreamError( root(), std::system_error(err, std::system_category()) );
+    }
+
+    [[noreturn]] void invalid() const
+    {
+        throw std::runtime_error("invalid tar archive: " + root().string());
+    }
+
+    char const * data_ = nullptr;
+    std::size_t size_ = 0;
+};
+
+// A tar archive if root is a ".tar" file, else a directory.
+std::shared_ptr<Source const> open_source(path const & root)
+{
+    boost::system::error_code ec;
+    if( root.extension() == ".tar" && is_regular_file(root, ec) )
+    {
+        return std::make_shared<TarSource>(root);
+    }
+
+    return std::make_shared<DirectorySource>(root);
+}
+
+// The rules of the .notesignore file of a source, if any.
+IgnoreRules load_ignore(Source const & source)
+{
+    IgnoreRules ignores;
+
+    ignores.add_regex(L"\\.notesignore");
+    ignores.add_regex(L"\\.notes_tool\\.sock");
+    ignores.add_regex(L"\\.notes_snapshot(\\.tmp)?");
+    ignores.add_regex(L"\\.notes_clean(\\.tmp)?");
+    ignores.add_regex(L"\\.git");
+    ignores.add_regex(L".*\\.eol\\.tmp");
+    ignores.add_regex(L".*\\.write\\.tmp");
+
+    std::string storage;
+    std::string_view bytes;
+    if( source.read(L".notesignore", storage, bytes) ) bytes = std::string_view();
+
+    std::wistringstream is( widen(bytes) );
+    wstring line;
+    bool glob = false;
+
+    while( getline(is, line) )
+    {
+        wstring trimmed = boost::algorithm::trim_copy(line);
+
+        if( trimmed == L"syntax: glob" )
+        {
+            glob = true;
+        }
+        else if( trimmed == L"syntax: regexp" )
+        {
+            glob = false;
+        }
+        else if( glob )
+        {
+            if( !trimmed.empty() && trimmed.front() != L'#' ) 
+                ignores.add_glob(trimmed);
+        }
+        else
+        {
+            ignores.add_regex(line);
+        }
+    }
+
+    return ignores;
+}
+
+IgnoreRules load_ignore(path const & root = ".")
+{
+    return load_ignore( DirectorySource(root) );
+}
+
+// The rules of the current directory, loaded on first use: commands
+// that list no notes do not read .notesignore nor compile its rules.
+IgnoreRules const & ignores()
+{
+    static IgnoreRules const rules = load_ignore();
+    return rules;
+}
+
+
+/*
+The entries of a notes directory, shared by the files listed with 
+it: the links of a note are resolved against it instead of going
+back to the disk.
+*/
+class Listing
+{
+public:
+    path directory;
+    std::shared_ptr<Source const> source;   // null if not from a scan
+    std::unordered_set<wstring> annexes;    // names
+
+    // Changes when a file is added or removed, or an annex changes.
+    uint64_t fingerprint = 0;
+
+    // Files are kept by hash of their name: 8 bytes a file, 
+    // however long the names.  Call sort_files() once all are added.
+    void add_file(wstring const & name)
+    {
+        files_.push_back( hash(name) );
+    }
+
+    void sort_files()
+    {
+        std::sort(files_.begin(), files_.end());
+        fingerprint = xxhash64( reinterpret_cast<char const *>(files_.data()), 
+            files_.size() * sizeof(files_[0]), fingerprint );
+    }
+
+    bool has_file(wstring const & name) const
+    {
+        return std::binary_search(files_.begin(), files_.end(), hash(name));
+    }
+
+    static uint64_t hash(wstring const & name)
+    {
+        return xxhash64( utf8_from_wide(name) );
+    }
+
+    // Under the directory, in the source of the scan.
+    bool exists(wstring const & relative) const
+    {
+        if( source ) return source->exists(relative);
+
+        boost::system::error_code ec;
+        return boost::filesystem::exists(directory / relative, ec);
+    }
+
+private:
+    vector<uint64_t> files_;
+};
+
+class File
+{
+public:
+    File() {}
+    File(path const & f, path const & a = path())
+        : filename(f), annex(a) {}
+
+    path filename;
+    path annex;
+    AnnexStats annex_stats;
+    std::shared_ptr<Listing const> listing; // null if not from a scan
+};
+
+/*
+The content of the file of a note, from the source of its scan if any:
+a view of storage, or of the memory of the source.  Returns 0 or an
+errno value.
+*/
+int read_note_file(File const & file, std::string & storage, std::string_view & bytes)
+{
+    if( file.listing && file.listing->source )
+    {
+        return file.listing->source->read(file.filename.filename().wstring(), 
+            storage, bytes);
+    }
+
+    int err = read_file(file.filename, storage);
+    bytes = storage;
+    return err;
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+
+class Name
+{
+public:
+    optional<wstring> sphere;
+    optional<wstring> project;
+    optional<wstring> subject;
+};
+
+
+/////////////////////////////////////////////////////////////////////////////
+
+bool parse_filename(File const & file, Name & name_out)
+{
+    name_out = Name();
+
+    // Compiled once: check_unique() parses every name, not only the changed.
+    static std::wregex const re(L"(\\S+) (\\S+) ([\\S ]+)");
+    std::wsmatch mr;
+    
+    wstring stem = nfc(file.filename.stem().wstring());
+
+    if( !regex_match(stem, mr, re) ) 
+        return false;
+
+    name_out.sphere  = wstring(L"#") + mr.str(1);
+    name_out.project = wstring(L"#") + mr.str(2);
+
+    wstring subject = mr.str(3);
+
+    if( isspace(subject.front()) || isspace(subject.back()) )
+        return false;
+
+    name_out.subject = subject;
+
+    return true;
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+
+bool is_tag(wstring const & t)
+{
+    if( t.size() <= 1 ) return false;
+    if( t[0] != L'#' ) return false;
+    if( boost::range::count_if( t, iswspace ) ) return false;
+    return std::count( t.begin() + 1, t.end(), L'#' ) == 0;
+}
+
+/*
+Splits on white space and validates each token in the same pass.
+On failure, tags_out is empty and bad_tag (if given) receives the
+first token that is not a tag.
+*/
+bool parse_tags(wstring const & tags_string, set<wstring> & tags_out,
+    wstring * bad_tag = nullptr)
+{
+    tags_out.clear();
+
+    auto p = tags_string.begin();
+    auto end = tags_string.end();
+
+    for(;;)
+    {
+        while( p != end && iswspace(*p) ) ++p;
+        if( p == end ) break;
+
+        auto token = p;
+        bool valid = *p == L'#';
+
+        for(++p; p != end && !iswspace(*p); ++p)
+        {
+            if( *p == L'#' ) valid = false;
+        }
+
+        if( !valid || p - token == 1 )
+        {
+            tags_out.clear();
+            if( bad_tag ) bad_tag->assign(token, p);
+            return false;
+        }
+
+        tags_out.insert( nfc(wstring(token, p)) );
+    }
+
+    return true;
+}
+
+wstring print_tags(set<wstring> const & tags)
+{
+    wstring r;
+
+    for(auto t: tags)
+    {
+        r += t + L' ';
+    }
+
+    if( !r.empty() ) 
+    {
+        r.erase(r.end()-1);
+    }
+
+    return r;
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+
+bool parse_header_field(wstring const & line, wstring & name, wstring & body)
+{
+    std::wregex re(L"(\\S+):(.*)\n?");
+    std::wsmatch mr;
+    
+    if( !regex_match(line, mr, re) ) 
+        return false;
+
+    name = mr.str(1);
+    boost::algorithm::trim(name);
+
+    body = mr.str(2);
+    boost::algorithm::trim(body);
+
+    return true;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+
+// "Other%20note.md#part" -> "Other note.md", none for URLs and anchors.
+optional<wstring> local_link(wstring target)
+{
+    if( target.size() >= 2 && target.front() == L'<' && target.back() == L'>' )
+    {
+        target = target.substr(1, target.size() - 2);
+    }
+
+    target = target.substr( 0, std::min(target.find(L'#'), target.find(L'?')) );
+
+    // "https:", "mailto:"... or an absolute path.
+    auto colon = target.find(L':');
+    if( target.empty() || target[0] == L'/' || 
+        (colon != wstring::npos && colon < target.find(L'/')) )
+    {
+        return boost::none;
+    }
+
+    if( target.find(L'%') != wstring::npos )
+    {
+        std::string utf8;
+        for(std::size_t i = 0; i != target.size(); ++i)
+        {
+            if( target[i] == L'%' && i + 2 < target.size() && 
+                iswxdigit(target[i + 1]) && iswxdigit(target[i + 2]) )
+            {
+                utf8 += char( std::stoi(target.substr(i + 1, 2), nullptr, 16) );
+                i += 2;
+            }
+            else
+            {
+                utf8 += utf8_from_wide(wstring(1, target[i]));
+            }
+        }
+        target = wide_from_utf8(utf8);
+    }
+
+    // Without "." segments.
+    wstring r;
+    std::size_t begin = 0;
+    while( begin <= target.size() )
+    {
+        std::size_t end = std::min(target.find(L'/', begin), target.size());
+        wstring segment = target.substr(begin, end - begin);
+
+        if( !segment.empty() && segment != L"." ) 
+        {
+            r += (r.empty() ? L"" : L"/") + segment;
+        }
+
+        begin = end + 1;
+    }
+
+    if( r.empty() ) return boost::none;
+    return r;
+}
+
+// The links of one line, outside of code spans.  Every search stops
+// at the end of the line: a body is not searched once per line.
+void extract_line_links(wstring const & body, std::size_t begin, 
+    std::size_t end, vector<wstring> & links)
+{
+    // The position of the first of the characters, or end.
+    auto find = [&](wchar_t const * chars, std::size_t from)
+    {
+        return std::size_t(std::find_first_of(body.begin() + std::min(from, end), 
+            body.begin() + end, chars, chars + wcslen(chars)) - body.begin());
+    };
+
+    auto add = [&](wstring const & target)
+    {
+        auto local = local_link(target);
+        if( local ) links.push_back(*local);
+    };
+
+    // Reference definition: "[id]: target".
+    if( body[begin] == L'[' )
+    {
+        std::size_t close = find(L"]", begin);
+        if( close + 1 < end && body[close + 1] == L':' )
+        {
+            std::size_t t = close + 2;
+            while( t < end && (body[t] == L' ' || body[t] == L'\t') ) ++t;
+            if( t < end )
+            {
+                std::size_t t_end = find(L" \t", t);
+                add( body.substr(t, t_end - t) );
+            }
+            return;
+        }
+    }
+
+    for(std::size_t p = begin; p < end; ++p)
+    {
+        if( body[p] == L'`' )
+        {
+            p = find(L"`", p + 1);
+            if( p >= end ) return;
+        }
+        else if( body[p] == L']' && p + 1 < end && body[p + 1] == L'(' )
+        {
+            std::size_t t = p + 2;
+            std::size_t t_end = t;
+
+            if( t < end && body[t] == L'<' )
+            {
+                t_end = std::min(find(L">", t), end - 1) + 1;
+            }
+            else
+            {
+                // Up to the closing parenthesis.  Spaces are allowed, 
+                // as in note names.
+                int depth = 0;
+                for(; t_end < end; ++t_end)
+                {
+                    if( body[t_end] == L'(' ) ++depth;
+                    if( body[t_end] == L')' && depth-- == 0 ) break;
+                }
+            }
+
+            wstring target = body.substr(t, t_end - t);
+            p = t_end;
+
+            // Without the title: [text](target "title").
+            boost::algorithm::trim(target);
+            if( !target.empty() && (target.back() == L'"' || target.back() == L'\'') )
+            {
+                std::size_t open = target.rfind(wstring(L" ") + target.back(), target.size() - 2);
+                if( open != wstring::npos ) target.erase(open);
+            }
+
+            add(target);
+        }
+    }
+}
+
+/*
+The local targets of the Markdown links of a body: inline links and
+images, "[text](target)", and reference definitions, "[id]: target".
+What is in code is not a link.
+*/
+vector<wstring> extract_links(wstring const & body)
+{
+    vector<wstring> links;
+
+    if( body.find(L']') == wstring::npos ) return links;
+
+    bool fenced = false;
+
+    for(std::size_t begin = 0; begin < body.size(); )
+    {
+        std::size_t end = std::min(body.find(L'\n', begin), body.size());
+        std::size_t indent = std::min(body.find_first_not_of(L' ', begin), end);
+
+        if( indent - begin < 4 && (body.compare(indent, 3, L"```") == 0 ||
+            body.compare(indent, 3, L"~~~") == 0) )
+        {
+            fenced = !fenced;
+        }
+        else if( !fenced && indent != end )
+        {
+            extract_line_links(body, indent, end, links);
+        }
+
+        begin = end + 1;
+    }
+
+    return links;
+}
+
+
+/////////////////////////////////////////////////////////////////////////////
+
+class Note
+{
+public:
+
+    Note() {}
+
+    explicit Note(File fl)
+    {
+        file = fl;
+
+        parse_filename(file, name);
+        load_text();
+        parse_text(text);
+        parse_tags();
+        links = extract_links(body);
+    }
+
+    // From the content of the file, already read.
+    Note(File fl, std::string_view bytes)
+    {
+        file = fl;
+
+        parse_filename(file, name);
+        content_hash = xxhash64(bytes.data(), bytes.size());
+        text = widen(bytes);
+        parse_text(text);
+        parse_tags();
+        links = extract_links(body);
+    }
+
+    File file;
+    Name name;
+
+    wstring text;
+
+    map<wstring, wstring> header;
+    vector<wstring> header_order;   // The field names, as in the file.
+    wstring body;
+
+    // XXH64 of the bytes of the file.
+    uint64_t content_hash = 0;
+
+    // Where the body starts in text, in characters.
+    std::size_t body_offset = 0;
+
+    set<wstring> tags;
+
+    // The first token of the tags field that is not a tag.
+    optional<wstring> bad_tag;
+
+    // Local targets of the links of the body, see extract_links().
+    vector<wstring> links;
+
+    void write();
+
+    void parse_text(wstring const & text)
+    {
+        header.clear();
+        header_order.clear();
+        body.clear();
+        body_offset = 0;
+
+        std::wstringstream is(text);
+        wstring line;
+
+        std::size_t line_offset = 0;
+
+        while( getline(is, line) )
+        {
+            wstring field_name;
+            wstring field_body;
+            if( parse_header_field(line, field_name, field_body) )
+            {
+                if( header.find(field_name) == header.end() )
+                    header_order.push_back(field_name);
+                header[field_name] = field_body;
+                line_offset += line.size() + 1;
+            }
+            else
+            {
+                break;
+            }
+        }
+
+        body_offset = line_offset;
+
+        if( header.empty() )
+        {
+            // No header at all.  Body must include all the lines.
+            body += line + L"\n";
+        }
+        else
+        {
+            // There is an header.  Do not put the (normally present)
+            // empty line in the body.
+            wstring tmp(line);
+            boost::algorithm::trim(tmp);
+
+            if( !tmp.empty() )
+                body += line + L"\n";
+            else
+                body_offset = std::min(line_offset + line.size() + 1, text.size());
+        }
+        
+        while( getline(is, line) )
+            body += line + L"\n";
+    }
+
+private:
+    void load_text()
+    {
+        std::string storage;
+        std::string_view bytes;
+
+        int err = read_note_file(file, storage, bytes);
+        if( err )
+        {
+            throw IOStreamError( file.filename, 
+                std::system_error(err, std::system_category()) );
+        }
+
+        content_hash = xxhash64(bytes.data(), bytes.size());
+        text = widen(bytes);
+    }
+
+    void parse_tags()
+    {
+        auto field = header.find(TAG_FIELD_NAME);
+
+        if( field != header.end() )
+        {
+            wstring bad;
+            if( !::parse_tags( field->second, tags, &bad ) )
+            {
+                bad_tag = bad;
+            }
+        }
+    }
+};
+
+void Note::write()
+{
+    // Encoded like it is decoded when loaded.
+    std::wostringstream ws;
+
+    // The fields of the file in their order, then the new ones.
+    set<wstring> written;
+    for(auto const & name: header_order)
+    {
+        auto field = header.find(name);
+        if( field == header.end() ) continue;
+        ws << field->first << ": " << field->second << '\n';
+        written.insert(name);
+    }
+
+    for(auto const & field: header)
+    {
+        if( written.count(field.first) ) continue;
+        ws << field.first << ": " << field.second << '\n';
+    }
+
+    if( !header.empty() ) ws << '\n';
+
+    ws << body;
+
+    // To a temporary file that then replaces the note: a reader sees
+    // the old note or the new one, never a part of it.
+    path tmp = file.filename;
+    tmp += ".write.tmp";
+
+    auto fail = [&](int err)
+    {
+        unlink(tmp.string().c_str());
+        throw IOStreamError( file.filename, std::system_error(err, std::system_category()) );
+    };
+
+    int fd = open(tmp.string().c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if( fd < 0 ) throw IOStreamError( file.filename, std::system_error(errno, std::system_category()) );
+
+    std::string bytes = narrow(ws.str());
+    char const * p = bytes.data();
+    std::size_t left = bytes.size();
+    while( left )
+    {
+        ssize_t n = ::write(fd, p, left);
+        if( n < 0 && errno == EINTR ) continue;
+        if( n <= 0 )
+        {
+            int err = n < 0 ? errno : EIO;
+            close(fd);
+            fail(err);
+        }
+        p += n;
+        left -= n;
+    }
+
+    struct stat st;
+    if( stat(file.filename.string().c_str(), &st) == 0 ) 
+        fchmod(fd, st.st_mode & 07777);
+
+    // On the disk before the rename, or a crash could leave an empty note.
+    if( fsync(fd) != 0 )
+    {
+        int err = errno;
+        close(fd);
+        fail(err);
+    }
+    if( close(fd) != 0 ) fail(errno);
+
+    if( rename(tmp.string().c_str(), file.filename.string().c_str()) != 0 )
+        fail(errno);
+}
+
+
+/*
+The line ends rule of the notes: the CRs right before an LF are 
+removed, "\r\n" and "\r\r\n" both become "\n".  A CR elsewhere is
+kept.  Strips a block of bytes, appended to out.  The CRs at the end
+of the block are counted in crs until the next block tells what they
+are before; once the last block is done, crs CRs remain to append.
+
+Returns true if a CR was removed.  Works without decoding: CR and LF
+are never part of a multibyte character.
+*/
+bool strip_cr_block(char const * p, std::size_t n, std::size_t & crs, std::string & out)
+{
+    bool found = false;
+
+    for(char const * end = p + n; p != end; ++p)
+    {
+        if( *p == '\r' )
+        {
+            ++crs;
+            continue;
+        }
+
+        if( *p == '\n' ) found = found || crs;
+        else out.append(crs, '\r');
+
+        crs = 0;
+        out += *p;
+    }
+
+    return found;
+}
+
+// The bytes of a note with its line ends stripped, see strip_cr_block().
+std::string strip_cr(std::string const & bytes)
+{
+    std::string r;
+    r.reserve(bytes.size());
+
+    std::size_t crs = 0;
+    strip_cr_block(bytes.data(), bytes.size(), crs, r);
+    r.append(crs, '\r');
+    return r;
+}
+
+/*
+Strips the line ends of a file, see strip_cr_block(): blocks are
+copied to a temporary file next to it, which then replaces it.  Memory
+use does not depend on the size of the file.
+
+Returns false, leaving the file alone, if there was nothing to strip.
+*/
+bool strip_cr(path const & file)
+{
+    auto fail = [&](int err) -> bool
+    {
+        throw IOStreamError( file, std::system_error(err, std::system_category()) );
+    };
+
+    int in = ::open(file.string().c_str(), O_RDONLY | O_CLOEXEC);
+    if( in == -1 ) return fail(errno);
+
+    struct stat st;
+    if( fstat(in, &st) != 0 ) 
+    {
+        int err = errno;
+        close(in);
+        return fail(err);
+    }
+
+    path tmp = file;
+    tmp += ".eol.tmp";
+
+    int out = ::open(tmp.string().c_str(), 
+        O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, st.st_mode & 07777);
+    if( out == -1 ) 
+    {
+        int err = errno;
+        close(in);
+        return fail(err);
+    }
+
+    bool found = false;
+    int err = 0;
+
+    auto write_all = [&](char const * p, std::size_t size)
+    {
+        while( size && !err )
+        {
+            ssize_t w = write(out, p, size);
+            if( w < 0 ) err = errno;
+            else { p += w; size -= w; }
+        }
+    };
+
+    std::size_t crs = 0;
+
+    char buf[64 * 1024];
+    std::string stripped;
+    while( !err )
+    {
+        ssize_t n = read(in, buf, sizeof(buf));
+        if( n < 0 ) { err = errno; break; }
+        if( n == 0 ) break;
+
+        stripped.clear();
+        if( strip_cr_block(buf, n, crs, stripped) ) found = true;
+        write_all(stripped.data(), stripped.size());
+    }
+
+    stripped.assign(crs, '\r');
+    write_all(stripped.data(), stripped.size());
+
+    close(in);
+    if( !err && found && fsync(out) != 0 ) err = errno;
+    if( close(out) != 0 && !err ) err = errno;
+
+    if( err || !found )
+    {
+        unlink(tmp.string().c_str());
+        return err ? fail(err) : false;
+    }
+
+    if( rename(tmp.string().c_str(), file.string().c_str()) != 0 )
+    {
+        err = errno;
+        unlink(tmp.string().c_str());
+        return fail(err);
+    }
+
+    return true;
+}
+
+
+///////////////////////////////////////////////////////////////////////
+
+std::wostream & operator <<(std::wostream & os, Note const & n)
+{
+    os << "Note(" << n.file.filename << ")";
+    return os;
+}
+
+
+///////////////////////////////////////////////////////////////////////
+
+
+class DirectoryVisitor
+{
+public:
+    virtual ~DirectoryVisitor() {}
+    virtual bool directory(path p) = 0;
+    virtual bool file(File const &) = 0;
+
+    // A file that a visit of some notes only skips.
+    virtual void skipped(path const &) {}
+};
+
+
+// Bytes that change with the annex and its content.
+std::string annex_state(wstring const & name, AnnexStats const & stats)
+{
+    std::string state = utf8_from_wide(name);
+
+    for(uint64_t x: { uint64_t(stats.entries), uint64_t(stats.size), uint64_t(stats.newest) })
+    {
+        state.append(reinterpret_cast<char const *>(&x), sizeof(x));
+    }
+
+    return state;
+}
+
+/*
+Lists the source twice so that nothing kept grows with the number of
+notes, but the hashes of their names.  The first listing pairs the
+annexes and finds the orphan directories, the second hands the files
+to the visitor as they come.
+
+Given the stems of the notes to visit, only those notes, their annexes
+and the orphans of those stems are visited, without a second listing. 
+The other annexes are not listed: the listing has no fingerprint.  The
+other files are only named to the visitor, by skipped().
+*/
+bool visit(std::shared_ptr<Source const> source, DirectoryVisitor & visitor, 
+    IgnoreRules const & rules = ignores(), set<wstring> const * only = nullptr)
+{
+    path const & dir = source->root();
+
+    auto listing = std::make_shared<Listing>();
+    listing->directory = dir;
+    listing->source = source;
+
+    auto wanted = [&](wstring const & stem) { return !only || only->count(stem); };
+
+    vector<path> dirs;
+    vector<uint64_t> stems; // of the files, by hash
+    vector<path> wanted_files;
+    vector<path> skipped_files;
+
+    source->list([&](wstring const & name, bool is_dir)
+    {
+        if( rules.ignored(name, is_dir) ) return true;
+
+        path p = dir / name;
+
+        if( is_dir )
+        {
+            dirs.push_back(p);
+        }
+        else
+        {
+            listing->add_file(name);
+            stems.push_back( Listing::hash(p.stem().wstring()) );
+
+            if( only ) (wanted(p.stem().wstring()) ? wanted_files : skipped_files).push_back(p);
+        }
+
+        return true;
+    });
+
+    listing->sort_files();
+    std::sort(stems.begin(), stems.end());
+
+    // As many directories of a stem are annexes as there are files
+    // of that stem, the first ones listed.  The others are orphans.
+    map< wstring, std::deque< std::pair<path, AnnexStats> > > annexes;
+    for(auto const & d: dirs)
+    {
+        wstring stem = d.stem().wstring();
+        auto files = std::equal_range(stems.begin(), stems.end(), Listing::hash(stem));
+
+        auto & same_stem = annexes[stem];
+        if( same_stem.size() < std::size_t(files.second - files.first) )
+        {
+            wstring name = d.filename().wstring();
+
+            AnnexStats stats;
+            if( wanted(stem) ) source->list_annex(name, rules, stats);
+            same_stem.emplace_back(d, stats);
+
+            listing->annexes.insert(name);
+            listing->fingerprint = xxhash64(annex_state(name, stats), listing->fingerprint);
+        }
+        else if( wanted(stem) )
+        {
+            if( !visitor.directory(d) ) return false;
+        }
+    }
+
+    stems = vector<uint64_t>();
+    if( only ) listing->fingerprint = 0;
+
+    auto visit_file = [&](path const & p)
+    {
+        File file(p);
+        file.listing = listing;
+
+        // TODO: check for "annexes" extension
+        auto annex = annexes.find( file.filename.stem().wstring() );
+
+        if( annex != annexes.end() && !annex->second.empty() )
+        {
+            file.annex = annex->second.front().first;
+            file.annex_stats = annex->second.front().second;
+            annex->second.pop_front();
+        }
+
+        try
+        {
+            return visitor.file(file);
+        }
+        catch(IOStreamError const & error)
+        {
+            std::cerr << error.what() << "\n";
+            return true;
+        }
+    };
+
+    if( only )
+    {
+        for(auto const & p: skipped_files) visitor.skipped(p);
+
+        for(auto const & p: wanted_files)
+        {
+            if( !visit_file(p) ) return false;
+        }
+
+        return true;
+    }
+
+    return source->list([&](wstring const & name, bool is_dir)
+    {
+        if( is_dir || rules.ignored(name, false) ) return true;
+        return visit_file(dir / name);
+    });
+}
+
+bool visit(path const & dir, DirectoryVisitor & visitor, 
+    IgnoreRules const & rules = ignores(), set<wstring> const * only = nullptr)
+{
+    return visit(open_source(dir), visitor, rules, only);
+}
+
+///////////////////////////////////////////////////////////////////////
+
+template <typename T>
+class BoundedQueue
+{
+public:
+    explicit BoundedQueue(std::size_t capacity) : capacity_(capacity) {}
+
+    // Blocks while the queue is full.
+    void push(T value)
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        not_full_.wait(lock, [&]() { return items_.size() < capacity_; });
+        items_.push_back( std::move(value) );
+        not_empty_.notify_one();
+    }
+
+    // False once the queue is closed and empty.
+    bool pop(T & value)
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        not_empty_.wait(lock, [&]() { return !items_.empty() || closed_; });
+
+        if( items_.empty() ) return false;
+
+        value = std::move(items_.front());
+        items_.pop_front();
+        not_full_.notify_one();
+        return true;
+    }
+
+    void close()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        closed_ = true;
+        not_empty_.notify_all();
+    }
+
+private:
+    std::size_t capacity_;
+    std::deque<T> items_;
+    bool closed_ = false;
+
+    std::mutex mutex_;
+    std::condition_variable not_empty_;
+    std::condition_variable not_full_;
+};
+
+
+// The content of a file, or why it could not be read.
+struct LoadedFile
+{
+    std::size_t index = 0;
+    std::string bytes;
+    int error = 0;
+    bool in_source = false; // in the memory of its source, not read yet
+};
+
+
+#ifdef NOTES_TOOL_IO_URING
+
+/*
+Minimal io_uring, straight on the system calls: one submission and
+one completion ring, used from a single thread.
+*/
+class Uring
+{
+public:
+    explicit Uring(unsigned entries)
+    {
+        io_uring_params params{};
+        fd_ = syscall(__NR_io_uring_setup, entries, &params);
+        if( fd_ < 0 ) return;
+
+        sq_size_ = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+        cq_size_ = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+
+        if( params.features & IORING_FEAT_SINGLE_MMAP )
+        {
+            sq_size_ = cq_size_ = std::max(sq_size_, cq_size_);
+        }
+
+        sq_ = mmap(nullptr, sq_size_, PROT_READ | PROT_WRITE, 
+            MAP_SHARED | MAP_POPULATE, fd_, IORING_OFF_SQ_RING);
+
+        cq_ = (params.features & IORING_FEAT_SINGLE_MMAP) ? sq_ :
+            mmap(nullptr, cq_size_, PROT_READ | PROT_WRITE, 
+                MAP_SHARED | MAP_POPULATE, fd_, IORING_OFF_CQ_RING);
+
+        sqes_size_ = params.sq_entries * sizeof(io_uring_sqe);
+        sqes_ = static_cast<io_uring_sqe *>( mmap(nullptr, sqes_size_, 
+            PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd_, IORING_OFF_SQES) );
+
+        if( sq_ == MAP_FAILED || cq_ == MAP_FAILED || sqes_ == MAP_FAILED )
+        {
+            close(fd_);
+            fd_ = -1;
+            return;
+        }
+
+        char * sq = static_cast<char *>(sq_);
+        sq_tail_  = reinterpret_cast<uint32_t *>(sq + params.sq_off.tail);
+        sq_mask_  = *reinterpret_cast<uint32_t *>(sq + params.sq_off.ring_mask);
+        sq_array_ = reinterpret_cast<uint32_t *>(sq + params.sq_off.array);
+        sq_entries_ = params.sq_entries;
+
+        char * cq = static_cast<char *>(cq_);
+        cq_head_ = reinterpret_cast<uint32_t *>(cq + params.cq_off.head);
+        cq_tail_ = reinterpret_cast<uint32_t *>(cq + params.cq_off.tail);
+        cq_mask_ = *reinterpret_cast<uint32_t *>(cq + params.cq_off.ring_mask);
+        cqes_ = reinterpret_cast<io_uring_cqe *>(cq + params.cq_off.cqes);
+    }
+
+    Uring(Uring const &) = delete;
+    Uring & operator =(Uring const &) = delete;
+
+    ~Uring()
+    {
+        if( fd_ < 0 ) return;
+
+        munmap(sqes_, sqes_size_);
+        if( cq_ != sq_ ) munmap(cq_, cq_size_);
+        munmap(sq_, sq_size_);
+        close(fd_);
+    }
+
+    bool valid() const
+    {
+        return fd_ >= 0;
+    }
+
+    unsigned capacity() const
+    {
+        return sq_entries_;
+    }
+
+    // Fills the next submission, sent by submit().
+    io_uring_sqe & next(uint8_t opcode, uint64_t user_data)
+    {
+        uint32_t tail = *sq_tail_ + pending_;
+        uint32_t index = tail & sq_mask_;
+
+        io_uring_sqe & sqe = sqes_[index];
+        std::memset(&sqe, 0, sizeof(sqe));
+        sqe.opcode = opcode;
+        sqe.user_data = user_data;
+
+        sq_array_[index] = index;
+        ++pending_;
+
+        return sqe;
+    }
+
+    /*
+    Submits the pending entries, waits for all of them to complete
+    and calls f(user_data, result) for each.
+    */
+    template <typename Function>
+    void run(Function f)
+    {
+        unsigned to_submit = pending_;
+        unsigned left = pending_;
+
+        __atomic_store_n(sq_tail_, *sq_tail_ + pending_, __ATOMIC_RELEASE);
+        pending_ = 0;
+
+        while( left )
+        {
+            int r = syscall(__NR_io_uring_enter, fd_, to_submit, 1, 
+                IORING_ENTER_GETEVENTS, nullptr, 0);
+
+            if( r < 0 )
+            {
+                if( errno == EINTR ) continue;
+                throw std::system_error(errno, std::system_category(), "io_uring_enter");
+            }
+            to_submit -= r;
+
+            uint32_t head = *cq_head_;
+            uint32_t tail = __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE);
+
+            for(; head != tail; ++head, --left)
+            {
+                io_uring_cqe const & cqe = cqes_[head & cq_mask_];
+                f(cqe.user_data, cqe.res);
+            }
+
+            __atomic_store_n(cq_head_, head, __ATOMIC_RELEASE);
+        }
+    }
+
+private:
+    int fd_ = -1;
+
+    void * sq_ = MAP_FAILED;
+    void * cq_ = MAP_FAILED;
+    io_uring_sqe * sqes_ = static_cast<io_uring_sqe *>(MAP_FAILED);
+    std::size_t sq_size_ = 0;
+    std::size_t cq_size_ = 0;
+    std::size_t sqes_size_ = 0;
+
+    uint32_t * sq_tail_ = nullptr;
+    uint32_t * sq_array_ = nullptr;
+    uint32_t sq_mask_ = 0;
+    unsigned sq_entries_ = 0;
+    unsigned pending_ = 0;
+
+    uint32_t * cq_head_ = nullptr;
+    uint32_t * cq_tail_ = nullptr;
+    uint32_t cq_mask_ = 0;
+    io_uring_cqe * cqes_ = nullptr;
+};
+
+/*
+Reads the files by batches with io_uring: the opens and the sizes
+of a batch in one submission, then all the reads in another.
+
+Returns false if io_uring is not available, nothing was read then.
+*/
+template <typename Sink>
+bool load_files_uring(vector<File const *> const & files, Sink sink)
+{
+    Uring ring(128);
+    if( !ring.valid() ) return false;
+
+    std::size_t const BATCH = ring.capacity() / 2;
+
+    for(std::size_t begin = 0; begin < files.size(); begin += BATCH)
+    {
+        std::size_t n = std::min(BATCH, files.size() - begin);
+
+        vector<std::string> names(n);
+        vector<struct statx> stats(n);
+        vector<int> fds(n, -1);
+        vector<LoadedFile> loaded(n);
+
+        for(std::size_t i = 0; i != n; ++i)
+        {
+            names[i] = files[begin + i]->filename.string();
+            loaded[i].index = begin + i;
+
+            io_uring_sqe & open = ring.next(IORING_OP_OPENAT, i * 2);
+            open.fd = AT_FDCWD;
+            open.addr = reinterpret_cast<uint64_t>(names[i].c_str());
+            open.open_flags = O_RDONLY | O_CLOEXEC;
+
+            io_uring_sqe & size = ring.next(IORING_OP_STATX, i * 2 + 1);
+            size.fd = AT_FDCWD;
+            size.addr = reinterpret_cast<uint64_t>(names[i].c_str());
+            size.len = STATX_SIZE;
+            size.off = reinterpret_cast<uint64_t>(&stats[i]);
+        }
+
+        ring.run( [&](uint64_t data, int res)
+        {
+            std::size_t i = data / 2;
+
+            if( res < 0 ) loaded[i].error = -res;
+            else if( data % 2 == 0 ) fds[i] = res;
+        });
+
+        for(std::size_t i = 0; i != n; ++i)
+        {
+            if( fds[i] < 0 ) continue;
+
+            // One more byte tells whether the file grew.
+            loaded[i].bytes.resize(stats[i].stx_size + 1);
+
+            io_uring_sqe & read = ring.next(IORING_OP_READ, i);
+            read.fd = fds[i];
+            read.addr = reinterpret_cast<uint64_t>(&loaded[i].bytes[0]);
+            read.len = loaded[i].bytes.size();
+            read.off = 0;
+        }
+
+        ring.run( [&](uint64_t i, int res)
+        {
+            if( res < 0 )
+            {
+                loaded[i].error = -res;
+                loaded[i].bytes.clear();
+            }
+            else
+            {
+                loaded[i].bytes.resize(res);
+            }
+        });
+
+        for(std::size_t i = 0; i != n; ++i)
+        {
+            // A read can be short, on NFS or FUSE for instance: less 
+            // than the size is not the end of the file.
+            bool complete = loaded[i].bytes.size() == stats[i].stx_size;
+
+            if( fds[i] >= 0 ) close(fds[i]);
+
+            // Opens not supported by the kernel, a file that changed
+            // while read or a short read: read it the usual way.
+            if( (loaded[i].error == EINVAL && fds[i] < 0) || 
+                (!loaded[i].error && !complete) )
+            {
+                loaded[i].error = read_file(files[begin + i]->filename, loaded[i].bytes);
+            }
+            else if( loaded[i].error )
+            {
+                loaded[i].bytes.clear();
+            }
+
+            sink( std::move(loaded[i]) );
+        }
+    }
+
+    return true;
+}
+
+#endif
+
+// Reads the files with one blocking read per file, on all processors.
+template <typename Sink>
+void load_files_pread(vector<File const *> const & files, Sink sink)
+{
+    parallel_for(files.size(), [&](std::size_t i)
+    {
+        LoadedFile loaded;
+        loaded.index = i;
+        loaded.error = read_file(files[i]->filename, loaded.bytes);
+        sink( std::move(loaded) );
+    });
+}
+
+/*
+Reads the files on a loader thread and hands their content to 
+f(index, note) on worker threads through a bounded queue, so that
+parsing and checking overlap the reads.  f is called in any order.
+
+Reads go through io_uring when available, unless the environment
+has NOTES_TOOL_IO=pread.  The files of sources in memory are not 
+copied: the workers parse them where they are.  Read errors are 
+reported on the standard error, in the order of the files, once all
+files are done.
+
+If f throws, the workers drain the queue without parsing, so that the
+loader finishes, and the first exception is rethrown once it is 
+joined.
+*/
+template <typename Function>
+void load_pipeline(vector<File const *> const & files, Function f)
+{
+    BoundedQueue<LoadedFile> queue(256);
+    vector<std::string> errors(files.size());
+    std::exception_ptr loader_error;
+
+    vector<File const *> disk;
+    vector<std::size_t> disk_index;
+    vector<std::size_t> in_memory;
+
+    for(std::size_t i = 0; i != files.size(); ++i)
+    {
+        auto const & listing = files[i]->listing;
+        if( listing && listing->source && !listing->source->on_disk() )
+        {
+            in_memory.push_back(i);
+        }
+        else
+        {
+            disk.push_back(files[i]);
+            disk_index.push_back(i);
+        }
+    }
+
+    std::thread loader([&]()
+    {
+        auto sink = [&](LoadedFile && loaded) 
+        {
+            loaded.index = disk_index[loaded.index];
+            queue.push( std::move(loaded) ); 
+        };
+
+        try
+        {
+            for(auto i: in_memory)
+            {
+                LoadedFile loaded;
+                loaded.index = i;
+                loaded.in_source = true;
+                queue.push( std::move(loaded) );
+            }
+
+            char const * io = std::getenv("NOTES_TOOL_IO");
+            bool uring = !io || std::string(io) != "pread";
+            bool done = disk.empty();
+
+#ifdef NOTES_TOOL_IO_URING
+            if( uring && !done ) done = load_files_uring(disk, sink);
+#endif
+            if( !done ) load_files_pread(disk, sink);
+        }
+        catch(...)
+        {
+            loader_error = std::current_exception();
+        }
+
+        queue.close();
+    });
+
+    std::atomic<bool> failed{false};
+    std::exception_ptr worker_error;
+    std::mutex error_mutex;
+
+    auto work = [&](std::size_t)
+    {
+        LoadedFile loaded;
+        while( queue.pop(loaded) )
+        {
+            if( failed ) continue;
+
+            try
+            {
+                File const & file = *files[loaded.index];
+
+                std::string_view bytes = loaded.bytes;
+                if( loaded.in_source ) loaded.error = read_note_file(file, loaded.bytes, bytes);
+
+                if( loaded.error )
+                {
+                    errors[loaded.index] = IOStreamError( file.filename, 
+                        std::system_error(loaded.error, std::system_category()) ).what();
+                    continue;
+                }
+
+                f( loaded.index, Note(file, bytes) );
+            }
+            catch(...)
+            {
+                std::lock_guard<std::mutex> lock(error_mutex);
+                if( !worker_error ) worker_error = std::current_exception();
+                failed = true;
+            }
+        }
+    };
+
+    try
+    {
+        parallel_for( std::max<std::size_t>(1, std::thread::hardware_concurrency()), work );
+    }
+    catch(...)
+    {
+        // A worker could not start: parallel_for joined the others,
+        // the loader may be waiting on a full queue.  Drain here.
+        failed = true;
+        work(0);
+        loader.join();
+        throw;
+    }
+
+    loader.join();
+
+    for(auto const & error: errors)
+    {
+        if( !error.empty() ) std::cerr << error << "\n";
+    }
+
+    if( worker_error ) std::rethrow_exception(worker_error);
+    if( loader_error ) std::rethrow_exception(loader_error);
+}
+
+/*
+Loads the notes and calls f with each, in order, from the calling
+thread.  Files are taken by batches so that only a batch of notes
+is in memory at once.
+*/
+template <typename Function>
+void load_parallel(vector<File> const & files, Function f)
+{
+    std::size_t const BATCH = 1024;
+
+    for(std::size_t begin = 0; begin < files.size(); begin += BATCH)
+    {
+        std::size_t n = std::min(BATCH, files.size() - begin);
+
+        vector<File const *> batch;
+        for(std::size_t i = 0; i != n; ++i) batch.push_back(&files[begin + i]);
+
+        vector<optional<Note>> notes(n);
+
+        load_pipeline(batch, [&](std::size_t i, Note && note)
+        {
+            notes[i] = std::move(note);
+        });
+
+        for(auto const & note: notes)
+        {
+            if( note ) f(*note);
+        }
+    }
+}
+
+
+///////////////////////////////////////////////////////////////////////
+
+// Identifies a check in results stored outside of the process.
+enum CheckId
+{
+    NON_EMPTY_ANNEX_CHECK,
+    EXTENSION_CHECK,
+    FILENAME_CHECK,
+    HAS_SUBJECT_FIELD_CHECK,
+    HAS_TAGS_FIELD_CHECK,
+    TAGS_FORMAT_CHECK,
+    MATCHING_SUBJECTS_CHECK,
+    EOL_CHECK,
+    SPHERE_FILENAME_TAG_CHECK,
+    PROJECT_FILENAME_TAG_CHECK,
+    BROKEN_LINK_CHECK,
+    MISSING_ANNEX_FILE_CHECK,
+    DUPLICATE_SUBJECT_CHECK,    // across notes, see WarningVisitor
+    FILENAME_CLASH_CHECK,       // likewise
+    CHECK_COUNT
+};
+
+// Short name of a check, for reports and exports.
+char const * check_name(CheckId id)
+{
+    static char const * const names[CHECK_COUNT] = {
+        "non_empty_annex",
+        "extension",
+        "filename",
+        "has_subject_field",
+        "has_tags_field",
+        "tags_format",
+        "matching_subjects",
+        "eol",
+        "sphere_filename_tag",
+        "project_filename_tag",
+        "broken_link",
+        "missing_annex_file",
+        "duplicate_subject",
+        "filename_clash"
+    };
+
+    return names[id];
+}
+
+class BaseCheck
+{
+public:
+    explicit BaseCheck(Note const & note) : note_(note) {}
+
+    operator bool () const { return msg_.empty(); }
+
+    wstring message() const { return msg_; }
+
+protected:
+    Note const & note_; // checks do not outlive the note
+    wstring msg_;
+};
+
+
+class HasSubjectFieldCheck : public BaseCheck
+{
+public:
+    static constexpr CheckId id = HAS_SUBJECT_FIELD_CHECK;
+
+    explicit HasSubjectFieldCheck(Note const & note) : BaseCheck(note) 
+    {
+        auto end = note_.header.end();
+        auto subject_field = note_.header.find(SUBJECT_FIELD_NAME);
+
+        if( subject_field == end )
+        {
+            std::wostringstream os;
+            os << L"missing \"" << SUBJECT_FIELD_NAME << "\" header";
+            msg_ = os.str();
+        }
+        else
+        {
+            subject_ = (*subject_field).second;
+        }
+    }
+
+    wstring subject() const { return subject_; }
+
+protected:
+    wstring subject_;
+};
+
+
+class MatchingSubjectsCheck : public BaseCheck
+{
+public:
+    static constexpr CheckId id = MATCHING_SUBJECTS_CHECK;
+
+
+    explicit MatchingSubjectsCheck(Note const & note) : 
+        BaseCheck(note)
+    {
+        HasSubjectFieldCheck has_subject(note);
+
+        auto name_subject = note.name.subject;
+
+        if( name_subject ) subject_ = *name_subject;
+
+        if( has_subject && name_subject )
+        {
+            if( *name_subject != nfc(has_subject.subject()) )
+            {
+                msg_ = L"subject mismatch";
+            }
+        }
+    }
+
+    wstring subject() const { return subject_; }
+
+protected:
+    wstring subject_;
+};
+
+
+class NonEmptyAnnexCheck : public BaseCheck
+{
+public:
+    static constexpr CheckId id = NON_EMPTY_ANNEX_CHECK;
+
+    explicit NonEmptyAnnexCheck(Note const & note) : BaseCheck(note)
+    {
+        auto annex = note_.file.annex;
+        if( !annex.empty() )
+        {
+            if( note_.file.annex_stats.entries == 0 )
+            {
+                std::wstringstream ss;
+                ss << L"annex is empty: " << annex.wstring();
+                msg_ = ss.str();
+            }
+        }
+    }
+};
+
+bool has_note_extension(path const & file)
+{
+    return file.extension() == ".md";
+}
+
+class ExtensionCheck : public BaseCheck
+{
+public:
+    static constexpr CheckId id = EXTENSION_CHECK;
+
+    explicit ExtensionCheck(Note const & note) : BaseCheck(note)
+    {
+        if( !has_note_extension(note_.file.filename) )
+        {
+            msg_ = L"wrong extension";
+        }
+    }
+};
+
+class FilenameCheck : public BaseCheck
+{
+public:
+    static constexpr CheckId id = FILENAME_CHECK;
+
+    explicit FilenameCheck(Note const & note) : BaseCheck(note)
+    {
+        Name nm;
+        if( ! parse_filename(note_.file, nm) )
+        {
+            msg_ = L"filename format";
+        }
+    }
+};
+
+class HasTagsFieldCheck : public BaseCheck
+{
+public:
+    static constexpr CheckId id = HAS_TAGS_FIELD_CHECK;
+
+    explicit HasTagsFieldCheck(Note const & note) : BaseCheck(note)
+    {
+        auto end = note_.header.end();
+
+        if( note_.header.find(TAG_FIELD_NAME) == end )
+        {
+            std::wostringstream os;
+            os << L"missing \"" << TAG_FIELD_NAME << "\" header";
+            msg_ = os.str();
+        }
+    }
+};
+
+class TagsFormatCheck : public BaseCheck
+{
+public:
+    static constexpr CheckId id = TAGS_FORMAT_CHECK;
+
+    explicit TagsFormatCheck(Note const & note) : BaseCheck(note)
+    {
+        if( note_.bad_tag )
+        {
+            msg_ = L"not a tag: \"" + *note_.bad_tag + L"\"";
+        }
+    }
+};
+
+class EolCheck : public BaseCheck
+{
+public:
+    static constexpr CheckId id = EOL_CHECK;
+
+    explicit EolCheck(Note const & note) : BaseCheck(note)
+    {
+        // The CRs that strip_cr() removes: those before an LF.
+        if( note_.text.find(L"\r\n") != wstring::npos )
+        {
+            msg_ = L"CR detected";
+        }
+    }
+};
+
+class BaseFilenameTagCheck : public BaseCheck
+{
+public:
+    BaseFilenameTagCheck(Note const & note,
+        optional<wstring> const & fn_tag, wstring const & tag_desc) 
+        : BaseCheck(note)
+    {
+        if( fn_tag )
+        {
+            if( boost::range::count(note_.tags, *fn_tag) == 0 )
+            {
+                msg_ = tag_desc + L" from filename not found in tags";
+            }
+        }
+    }
+};
+
+class SphereFilenameTagCheck : public BaseFilenameTagCheck
+{
+public:
+    static constexpr CheckId id = SPHERE_FILENAME_TAG_CHECK;
+
+    SphereFilenameTagCheck(Note const & note) :
+        BaseFilenameTagCheck(note, note.name.sphere, L"sphere of life")
+    {}
+};
+
+class ProjectFilenameTagCheck : public BaseFilenameTagCheck
+{
+public:
+    static constexpr CheckId id = PROJECT_FILENAME_TAG_CHECK;
+
+    ProjectFilenameTagCheck(Note const & note) :
+        BaseFilenameTagCheck(note, note.name.project, L"project")
+    {}
+};
+
+enum LinkKind
+{
+    LINK_NOTE,
+    LINK_ANNEX_FILE,
+    LINK_OTHER,             // a file that is neither
+    LINK_BROKEN,
+    LINK_MISSING_ANNEX_FILE
+};
+
+struct ResolvedLink
+{
+    LinkKind kind;
+    wstring name;   // of the note linked, or of the annex
+};
+
+/*
+The links to a note of the listing or to one of its annexes cost no 
+system call.  The others, to a file in an annex included, are looked
+up in the source: the annex stats count the files, not name them.
+*/
+ResolvedLink resolve_link(Listing const & listing, wstring const & target)
+{
+    if( listing.has_file(target) ) return ResolvedLink{LINK_NOTE, target};
+
+    wstring annex = target.substr(0, target.find(L'/'));
+    if( listing.annexes.count(annex) )
+    {
+        bool found = annex == target || listing.exists(target);
+
+        return ResolvedLink{found ? LINK_ANNEX_FILE : LINK_MISSING_ANNEX_FILE, annex};
+    }
+
+    bool found = listing.exists(target);
+
+    return ResolvedLink{found ? LINK_OTHER : LINK_BROKEN, wstring()};
+}
+
+// Reports the links of the note that resolve to the given kind.
+class BaseLinkCheck : public BaseCheck
+{
+public:
+    BaseLinkCheck(Note const & note, LinkKind kind, wstring const & desc)
+        : BaseCheck(note)
+    {
+        if( !note_.file.listing ) return;
+
+        wstring bad;
+        for(auto const & link: note_.links)
+        {
+            if( resolve_link(*note_.file.listing, link).kind == kind )
+            {
+                bad += (bad.empty() ? L"\"" : L", \"") + link + L"\"";
+            }
+        }
+
+        if( !bad.empty() ) msg_ = desc + L": " + bad;
+    }
+};
+
+class BrokenLinkCheck : public BaseLinkCheck
+{
+public:
+    static constexpr CheckId id = BROKEN_LINK_CHECK;
+
+    explicit BrokenLinkCheck(Note const & note) :
+        BaseLinkCheck(note, LINK_BROKEN, L"broken link")
+    {}
+};
+
+class MissingAnnexFileCheck : public BaseLinkCheck
+{
+public:
+    static constexpr CheckId id = MISSING_ANNEX_FILE_CHECK;
+
+    explicit MissingAnnexFileCheck(Note const & note) :
+        BaseLinkCheck(note, LINK_MISSING_ANNEX_FILE, L"missing annex file")
+    {}
+};
+
+template <typename CheckType>
+struct check_type
+{
+    typedef CheckType type;
+};
+
+/*
+Calls f with a check_type<> for every check a note goes through, 
+in the order they are reported.
+*/
+template <typename Function>
+void for_each_check(Function && f)
+{
+    f( check_type<NonEmptyAnnexCheck>() );
+
+    f( check_type<ExtensionCheck>() );
+
+    f( check_type<FilenameCheck>() );
+
+    f( check_type<HasSubjectFieldCheck>() );
+
+    f( check_type<HasTagsFieldCheck>() );
+
+    f( check_type<TagsFormatCheck>() );
+
+    f( check_type<MatchingSubjectsCheck>() );
+
+    f( check_type<EolCheck>() );
+
+    f( check_type<SphereFilenameTagCheck>() );
+    f( check_type<ProjectFilenameTagCheck>() );
+
+    f( check_type<BrokenLinkCheck>() );
+    f( check_type<MissingAnnexFileCheck>() );
+}
+
+// Bit set of the checks the note fails, by CheckId.
+uint32_t failed_checks(Note const & note)
+{
+    uint32_t failed = 0;
+
+    for_each_check( [&](auto t)
+    {
+        typedef typename decltype(t)::type CheckType;
+
+        if( !CheckType(note) ) failed |= uint32_t{1} << CheckType::id;
+    });
+
+    return failed;
+}
+
+
+///////////////////////////////////////////////////////////////////////
+
+// Bump when a check changes what it accepts: clean markers are lost.
+uint32_t const CHECKS_VERSION = 1;
+
+/*
+Whether the result of the checks of a note can be remembered: not if
+it links out of its directory, that is not followed.
+*/
+bool checks_can_be_remembered(Note const & note)
+{
+    for(auto const & link: note.links)
+    {
+        if( !note.file.listing ) return false;
+        if( resolve_link(*note.file.listing, link).kind == LINK_OTHER ) return false;
+    }
+
+    return true;
+}
+
+/*
+What the checks of a note depend on besides its content: its annex
+and, if it has links, the files of its directory.
+*/
+uint64_t check_context(File const & file, bool links)
+{
+    uint64_t seed = links && file.listing ? file.listing->fingerprint : 0;
+    return xxhash64(annex_state(file.annex.wstring(), file.annex_stats), seed);
+}
+
+/*
+The notes found clean, kept between runs in the .notes_clean file of
+their directory, so that check and repair skip them while they do not
+change.  A note has not changed if its size and modification time are
+the same, just a stat, or else if the hash of its content is the same.
+
+One line per note: content hash, modification time, size, context 
+(for check), whether it has links, markers and name.
+*/
+class CleanStore
+{
+public:
+    enum Marker
+    {
+        CHECKED  = 1,   // passes all the checks
+        REPAIRED = 2    // no repair to offer
+    };
+
+    void load(path const & root)
+    {
+        entries_.clear();
+        changed_ = false;
+
+        std::ifstream fs( (root / CLEAN_STORE_NAME).string(), std::ios::binary );
+        std::string line;
+
+        if( !getline(fs, line) || line != header() ) return;
+
+        while( getline(fs, line) )
+        {
+            std::istringstream is(line);
+            Entry e;
+            is >> std::hex >> e.hash >> std::dec >> e.mtime >> e.size;
+            is >> std::hex >> e.context >> std::dec >> e.links >> e.markers;
+
+            std::string name;
+            if( is.get() != ' ' || !getline(is, name) ) continue;
+
+            entries_[wide_from_utf8(name)] = e;
+        }
+    }
+
+    // Keeps only the notes seen since load(), through a temporary file.
+    void save(path const & root) const
+    {
+        bool all_seen = std::all_of(entries_.begin(), entries_.end(), 
+            [](auto const & e) { return e.second.seen; });
+        if( !changed_ && all_seen ) return;
+
+        path file = root / CLEAN_STORE_NAME;
+        path tmp = file;
+        tmp += ".tmp";
+
+        std::ofstream fs(tmp.string(), std::ios::binary);
+        fs << header() << '\n';
+
+        for(auto const & e: entries_)
+        {
+            // Not seen: deleted, or the run stopped early.
+            Entry const & x = e.second;
+            if( !x.markers ) continue;
+            if( !x.seen && !exists(root / e.first) ) continue;
+
+            fs << std::hex << x.hash << std::dec << ' ' << x.mtime << ' ' << x.size << ' ';
+            fs << std::hex << x.context << std::dec << ' ' << x.links << ' ' << x.markers;
+            fs << ' ' << utf8_from_wide(e.first) << '\n';
+        }
+
+        fs.close();
+
+        if( !fs )
+        {
+            throw std::system_error(errno, std::system_category(), tmp.string());
+        }
+
+        boost::filesystem::rename(tmp, file);
+    }
+
+    // Just a stat: the file did not change since it was marked.
+    bool unchanged(File const & file, int64_t mtime, uint64_t size, Marker marker)
+    {
+        auto it = entries_.find( file.filename.filename().wstring() );
+        if( it == entries_.end() ) return false;
+
+        Entry & e = it->second;
+        if( e.mtime != mtime || e.size != size || !valid(file, e, marker) ) return false;
+
+        e.seen = true;
+        return true;
+    }
+
+    /*
+    Read but not parsed yet: the content did not change since it was 
+    marked.  Safe from several threads, it changes nothing.
+    */
+    bool same_content(File const & file, uint64_t hash, Marker marker) const
+    {
+        auto it = entries_.find( file.filename.filename().wstring() );
+        if( it == entries_.end() ) return false;
+
+        return it->second.hash == hash && valid(file, it->second, marker);
+    }
+
+    void mark(File const & file, uint64_t hash, int64_t mtime, uint64_t size,
+        Marker marker, uint64_t context = 0, bool links = false)
+    {
+        Entry & e = entries_[file.filename.filename().wstring()];
+        changed_ = true;
+
+        if( e.hash != hash ) e.markers = 0;
+
+        e.hash = hash;
+        e.mtime = mtime;
+        e.size = size;
+        e.markers |= marker;
+        e.seen = true;
+
+        if( marker == CHECKED )
+        {
+            e.context = context;
+            e.links = links;
+        }
+    }
+
+    // Same content, another modification time.
+    void touch(File const & file, int64_t mtime, uint64_t size)
+    {
+        Entry & e = entries_[file.filename.filename().wstring()];
+        changed_ = true;
+
+        e.mtime = mtime;
+        e.size = size;
+        e.seen = true;
+    }
+
+    // Seen, but not clean anymore.
+    void unmark(File const & file, Marker marker)
+    {
+        auto it = entries_.find( file.filename.filename().wstring() );
+        if( it == entries_.end() ) return;
+
+        changed_ = changed_ || (it->second.markers & marker);
+        it->second.markers &= ~marker;
+        it->second.seen = true;
+    }
+
+private:
+    struct Entry
+    {
+        uint64_t hash = 0;
+        int64_t mtime = 0;
+        uint64_t size = 0;
+        uint64_t context = 0;
+        bool links = false;
+        unsigned markers = 0;
+        bool seen = false;
+    };
+
+    static std::string header()
+    {
+        return "notes_clean 1 checks " + std::to_string(CHECKS_VERSION);
+    }
+
+    static bool valid(File const & file, Entry const & e, Marker marker)
+    {
+        if( !(e.markers & marker) ) return false;
+        return marker != CHECKED || e.context == check_context(file, e.links);
+    }
+
+    map<wstring, Entry> entries_;
+    bool changed_ = false;
+};
+
+// The store only saves time: failing to save it is not an error.
+void save_clean_store(CleanStore const & store, path const & root)
+{
+    try
+    {
+        store.save(root);
+    }
+    catch(std::exception const & error)
+    {
+        std::cerr << "warning: " << error.what() << "\n";
+    }
+}
+
+
+///////////////////////////////////////////////////////////////////////
+
+/*
+Healers diagnose a note when constructed.  heal() only changes the
+note in memory: writing it back is up to the caller.
+*/
+class BaseHealer
+{
+public:
+
+    explicit BaseHealer(Note & note) : note_(note) {}
+
+protected:
+    Note & note_;
+};
+
+class SubjectFieldHealer : public BaseHealer
+{
+public:
+
+    explicit SubjectFieldHealer(Note & note)
+        : BaseHealer(note), matching_(note), has_(note) {}
+
+    operator bool () const
+    {
+        if( !has_ ) return false;
+        if( !matching_ ) return false;
+        return true;
+    }
+
+    wstring message() const
+    {
+        if( !has_ ) return has_.message();
+        return matching_.message();
+    }
+
+    void heal()
+    {
+        note_.header[SUBJECT_FIELD_NAME] = matching_.subject();
+    }
+
+protected:
+    MatchingSubjectsCheck matching_;
+    HasSubjectFieldCheck has_;
+};
+
+class TagsFieldHealer : public BaseHealer
+{
+public:
+    explicit TagsFieldHealer(Note & note) : BaseHealer(note),
+        has_(note), filename_(note), sphere_(note), project_(note)
+    {}
+
+    operator bool() const
+    {
+        // Healing would write back only the tags that parsed, none.
+        if( note_.bad_tag ) return true;
+
+        if( filename_ )
+        {
+            if( !has_ || !sphere_ || !project_ )
+            {
+                return false;
+            }
+        }
+        // else, cannot heal.
+        return true;
+    }
+
+    wstring message() const
+    {
+        if( note_.bad_tag ) return wstring();
+
+        if( filename_ )
+        {
+            if( !has_ )
+            {
+                return has_.message();
+            }
+            else if( !sphere_ || !project_ )
+            {
+                return L"tag(s) from filename are missing";
+            }
+        }
+        // else, cannot heal.
+        return wstring();
+    }
+
+    void heal()
+    {
+        note_.tags.insert(*note_.name.sphere);
+        note_.tags.insert(*note_.name.project);
+        note_.header[TAG_FIELD_NAME] = print_tags(note_.tags);
+    }
+
+private:
+    HasTagsFieldCheck has_;
+    FilenameCheck filename_;
+    SphereFilenameTagCheck sphere_;
+    ProjectFilenameTagCheck project_;
+};
+
+class EolHealer : public BaseHealer
+{
+public:
+    explicit EolHealer(Note & note) : BaseHealer(note),
+        eol_(note)
+    {}
+
+    operator bool () const
+    {
+        return eol_;
+    }
+
+    wstring message() const
+    {
+        return eol_.message();
+    }
+
+    // The note without CRs is loaded apart, see HealerVisitor.
+
+private:
+    EolCheck eol_;
+};
+
+
+///////////////////////////////////////////////////////////////////////
+
+/*
+Set of note ids, compressed like Roaring bitmaps: ids are split on
+their upper 16 bits, each part keeps its lower 16 bits either as a
+sorted array (sparse) or as a 65536 bits set (dense).
+*/
+class TagBitmap
+{
+public:
+    void add(uint32_t id)
+    {
+        uint16_t key = id >> 16;
+        uint16_t low = id & 0xFFFF;
+
+        auto it = std::lower_bound(containers_.begin(), containers_.end(), key,
+            [](Container const & c, uint16_t k) { return c.key < k; });
+
+        if( it == containers_.end() || it->key != key )
+        {
+            it = containers_.insert(it, Container());
+            it->key = key;
+        }
+
+        it->add(low);
+    }
+
+    bool contains(uint32_t id) const
+    {
+        auto c = find(id >> 16);
+        return c && c->contains(id & 0xFFFF);
+    }
+
+    std::size_t count() const
+    {
+        std::size_t n = 0;
+        for(auto const & c: containers_) n += c.count();
+        return n;
+    }
+
+    bool empty() const
+    {
+        return containers_.empty();
+    }
+
+    TagBitmap operator &(TagBitmap const & other) const
+    {
+        TagBitmap r;
+        for(auto const & c: containers_)
+        {
+            auto o = other.find(c.key);
+            if( o ) r.push( c.intersect(*o) );
+        }
+        return r;
+    }
+
+    TagBitmap operator |(TagBitmap const & other) const
+    {
+        TagBitmap r;
+        auto a = containers_.begin();
+        auto b = other.containers_.begin();
+
+        while( a != containers_.end() || b != other.containers_.end() )
+        {
+            if( b == other.containers_.end() || (a != containers_.end() && a->key < b->key) )
+            {
+                r.push(*a++);
+            }
+            else if( a == containers_.end() || b->key < a->key )
+            {
+                r.push(*b++);
+            }
+            else
+            {
+                r.push( (a++)->unite(*b++) );
+            }
+        }
+        return r;
+    }
+
+    // The ids of this set that are not in the other.
+    TagBitmap operator -(TagBitmap const & other) const
+    {
+        TagBitmap r;
+        for(auto const & c: containers_)
+        {
+            auto o = other.find(c.key);
+            if( o ) r.push( c.subtract(*o) );
+            else r.push(c);
+        }
+        return r;
+    }
+
+    template <typename Function>
+    void for_each(Function && f) const
+    {
+        for(auto const & c: containers_)
+        {
+            uint32_t high = uint32_t{c.key} << 16;
+
+            if( c.bits.empty() )
+            {
+                for(auto low: c.array) f(high | low);
+            }
+            else
+            {
+                for(uint32_t w = 0; w != c.bits.size(); ++w)
+                {
+                    for(uint64_t word = c.bits[w]; word; word &= word - 1)
+                    {
+                        f(high | (w * 64 + __builtin_ctzll(word)));
+                    }
+                }
+            }
+        }
+    }
+
+private:
+    // An array container beyond this size is larger than a bit set.
+    static std::size_t const MAX_ARRAY = 4096;
+
+    struct Container
+    {
+        uint16_t key = 0;
+        vector<uint16_t> array; // sorted, used while bits is empty
+        vector<uint64_t> bits;
+
+        void add(uint16_t low)
+        {
+            if( !bits.empty() )
+            {
+                bits[low / 64] |= uint64_t{1} << (low % 64);
+                return;
+            }
+
+            // Notes are numbered in scan order, appending is the usual case.
+            if( array.empty() || array.back() < low )
+            {
+                array.push_back(low);
+            }
+            else
+            {
+                auto it = std::lower_bound(array.begin(), array.end(), low);
+                if( *it == low ) return;
+                array.insert(it, low);
+            }
+
+            if( array.size() > MAX_ARRAY ) to_bits();
+        }
+
+        bool contains(uint16_t low) const
+        {
+            if( !bits.empty() ) return (bits[low / 64] >> (low % 64)) & 1;
+            return std::binary_search(array.begin(), array.end(), low);
+        }
+
+        std::size_t count() const
+        {
+            if( bits.empty() ) return array.size();
+
+            std::size_t n = 0;
+            for(auto w: bits) n += __builtin_popcountll(w);
+            return n;
+        }
+
+        void to_bits()
+        {
+            bits.assign(65536 / 64, 0);
+            for(auto low: array) bits[low / 64] |= uint64_t{1} << (low % 64);
+            array.clear();
+            array.shrink_to_fit();
+        }
+
+        // Back to an array if small enough.
+        void compact()
+        {
+            if( bits.empty() || count() > MAX_ARRAY ) return;
+
+            for(uint32_t w = 0; w != bits.size(); ++w)
+            {
+                for(uint64_t word = bits[w]; word; word &= word - 1)
+                {
+                    array.push_back(w * 64 + __builtin_ctzll(word));
+                }
+            }
+            bits.clear();
+            bits.shrink_to_fit();
+        }
+
+        /*
+        The operations go by the kinds of the containers: arrays are
+        merged, an array is probed against a bit set, and only two bit
+        sets are combined word by word.  Rare tags stay cheap.
+        */
+        Container intersect(Container const & other) const
+        {
+            Container r;
+            r.key = key;
+
+            if( bits.empty() && other.bits.empty() )
+            {
+                std::set_intersection(array.begin(), array.end(), 
+                    other.array.begin(), other.array.end(), std::back_inserter(r.array));
+            }
+            else if( bits.empty() || other.bits.empty() )
+            {
+                Container const & a = bits.empty() ? *this : other;
+                Container const & b = bits.empty() ? other : *this;
+                for(auto low: a.array) if( b.contains(low) ) r.array.push_back(low);
+            }
+            else
+            {
+                r.bits.resize(bits.size());
+                for(std::size_t w = 0; w != bits.size(); ++w) r.bits[w] = bits[w] & other.bits[w];
+                r.compact();
+            }
+
+            return r;
+        }
+
+        Container unite(Container const & other) const
+        {
+            Container r;
+            r.key = key;
+
+            if( bits.empty() && other.bits.empty() )
+            {
+                std::set_union(array.begin(), array.end(), 
+                    other.array.begin(), other.array.end(), std::back_inserter(r.array));
+                if( r.array.size() > MAX_ARRAY ) r.to_bits();
+            }
+            else if( bits.empty() || other.bits.empty() )
+            {
+                Container const & a = bits.empty() ? *this : other;
+                r.bits = bits.empty() ? other.bits : bits;
+                for(auto low: a.array) r.bits[low / 64] |= uint64_t{1} << (low % 64);
+            }
+            else
+            {
+                r.bits.resize(bits.size());
+                for(std::size_t w = 0; w != bits.size(); ++w) r.bits[w] = bits[w] | other.bits[w];
+            }
+
+            return r;
+        }
+
+        // The values of this container that are not in the other.
+        Container subtract(Container const & other) const
+        {
+            Container r;
+            r.key = key;
+
+            if( bits.empty() && other.bits.empty() )
+            {
+                std::set_difference(array.begin(), array.end(), 
+                    other.array.begin(), other.array.end(), std::back_inserter(r.array));
+            }
+            else if( bits.empty() )
+            {
+                for(auto low: array) if( !other.contains(low) ) r.array.push_back(low);
+            }
+            else
+            {
+                r.bits = bits;
+                if( other.bits.empty() )
+                {
+                    for(auto low: other.array) r.bits[low / 64] &= ~(uint64_t{1} << (low % 64));
+                }
+                else
+                {
+                    for(std::size_t w = 0; w != bits.size(); ++w) r.bits[w] &= ~other.bits[w];
+                }
+                r.compact();
+            }
+
+            return r;
+        }
+    };
+
+    Container const * find(uint16_t key) const
+    {
+        auto it = std::lower_bound(containers_.begin(), containers_.end(), key,
+            [](Container const & c, uint16_t k) { return c.key < k; });
+
+        if( it == containers_.end() || it->key != key ) return nullptr;
+        return &*it;
+    }
+
+    void push(Container const & c)
+    {
+        if( c.count() ) containers_.push_back(c);
+    }
+
+    vector<Container> containers_;
+};
+
+
+/*
+For each tag, the notes that carry it, either in their "Étiquettes"
+header or as sphere or project of their filename.
+*/
+class TagIndex
+{
+public:
+    uint32_t add(Note const & note)
+    {
+        uint32_t id = notes_.size();
+        notes_.push_back(note.file.filename);
+        all_.add(id);
+
+        if( note.name.sphere  ) bitmaps_[*note.name.sphere ].add(id);
+        if( note.name.project ) bitmaps_[*note.name.project].add(id);
+
+        for(auto const & tag: note.tags)
+        {
+            bitmaps_[tag].add(id);
+        }
+
+        return id;
+    }
+
+    TagBitmap const & notes_with(wstring const & tag) const
+    {
+        static TagBitmap const none;
+
+        auto it = bitmaps_.find(tag);
+        return it == bitmaps_.end() ? none : it->second;
+    }
+
+    TagBitmap const & all() const
+    {
+        return all_;
+    }
+
+    path const & filename(uint32_t id) const
+    {
+        return notes_[id];
+    }
+
+    map<wstring, TagBitmap> const & bitmaps() const
+    {
+        return bitmaps_;
+    }
+
+    /*
+    Evaluates a boolean tag expression, e.g.
+
+        #projectX & #infra & !#archived
+        #work (#a | #b)
+
+    "and", "or", "not" and "-" may be used instead of "&", "|" and
+    "!".  Terms next to each other are and-ed.
+    */
+    TagBitmap query(wstring const & expression) const
+    {
+        tokens_ = query_tokens(expression);
+        next_ = 0;
+
+        TagBitmap r = query_or();
+
+        if( next_ != tokens_.size() )
+        {
+            throw std::invalid_argument("query: unexpected \"" +
+                narrow(tokens_[next_]) + "\"");
+        }
+        return r;
+    }
+
+private:
+    static vector<wstring> query_tokens(wstring const & expression)
+    {
+        vector<wstring> tokens;
+        wstring word;
+
+        auto flush = [&]()
+        {
+            if( word.empty() ) return;
+
+            wstring lo(word);
+            boost::algorithm::to_lower(lo);
+
+            if     ( lo == L"and" ) tokens.push_back(L"&");
+            else if( lo == L"or"  ) tokens.push_back(L"|");
+            else if( lo == L"not" ) tokens.push_back(L"!");
+            else tokens.push_back(word);
+
+            word.clear();
+        };
+
+        for(wchar_t c: expression)
+        {
+            if( iswspace(c) )
+            {
+                flush();
+            }
+            else if( c == L'(' || c == L')' || c == L'&' || c == L'|' || c == L'!' ||
+                (c == L'-' && word.empty()) )
+            {
+                flush();
+                tokens.push_back( wstring(1, c == L'-' ? L'!' : c) );
+            }
+            else
+            {
+                word += c;
+            }
+        }
+        flush();
+
+        return tokens;
+    }
+
+    bool accept(wchar_t const * token) const
+    {
+        if( next_ < tokens_.size() && tokens_[next_] == token )
+        {
+            ++next_;
+            return true;
+        }
+        return false;
+    }
+
+    TagBitmap query_or() const
+    {
+        TagBitmap r = query_and();
+        while( accept(L"|") ) r = r | query_and();
+        return r;
+    }
+
+    TagBitmap query_and() const
+    {
+        TagBitmap r = query_not();
+
+        for(;;)
+        {
+            if( accept(L"&") )
+            {
+                r = r & query_not();
+            }
+            else if( next_ < tokens_.size() && tokens_[next_] != L"|" && tokens_[next_] != L")" )
+            {
+                r = r & query_not();
+            }
+            else
+            {
+                return r;
+            }
+        }
+    }
+
+    TagBitmap query_not() const
+    {
+        if( accept(L"!") ) return all_ - query_not();
+
+        if( accept(L"(") )
+        {
+            TagBitmap r = query_or();
+            if( !accept(L")") ) throw std::invalid_argument("query: missing \")\"");
+            return r;
+        }
+
+        if( next_ == tokens_.size() ) throw std::invalid_argument("query: tag expected");
+
+        wstring const & tag = tokens_[next_++];
+        if( !is_tag(tag) ) 
+        {
+            throw std::invalid_argument("query: \"" + narrow(tag) + "\" is not a tag");
+        }
+        // Stored in form C, like parse_tags() leaves them.
+        return notes_with( nfc(tag) );
+    }
+
+    vector<path> notes_;
+    TagBitmap all_;
+    map<wstring, TagBitmap> bitmaps_;
+
+    mutable vector<wstring> tokens_;
+    mutable std::size_t next_ = 0;
+};
+
+
+///////////////////////////////////////////////////////////////////////
+
+// Results of "check --shard" and "tags --shard", for "merge".
+char const RESULTS_MAGIC[8] = { 'N', 'O', 'T', 'E', 'S', 'R', 'E', 'S' };
+uint32_t const RESULTS_VERSION = 3;
+
+enum ResultsKind { CHECK_RESULTS = 1, TAGS_RESULTS = 2 };
+
+struct ResultsHeader
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t check_count;
+    uint32_t kind;
+    uint32_t shard;     // 1 to shards
+    uint32_t shards;
+    uint32_t reserved;
+    uint64_t size;
+    uint64_t checksum;
+};
+
+/*
+The results of a shard, as they are written: numbers are uint32, 
+strings are a uint32 length and UTF-8 bytes.
+*/
+class ResultsWriter
+{
+public:
+    void put(uint32_t n)
+    {
+        data_.append(reinterpret_cast<char const *>(&n), sizeof(n));
+    }
+
+    void put(wstring const & s)
+    {
+        std::string utf8 = utf8_from_wide(s);
+        put( uint32_t(utf8.size()) );
+        data_ += utf8;
+    }
+
+    void save(path const & file, ResultsKind kind, uint32_t shard, uint32_t shards) const
+    {
+        ResultsHeader header{};
+        std::copy(RESULTS_MAGIC, RESULTS_MAGIC + 8, header.magic);
+        header.version = RESULTS_VERSION;
+        header.check_count = CHECK_COUNT;
+        header.kind = kind;
+        header.shard = shard;
+        header.shards = shards;
+        header.size = sizeof(header) + data_.size();
+        header.checksum = fnv1a(data_.data(), data_.size());
+
+        path tmp = file;
+        tmp += ".tmp";
+
+        std::ofstream fs(tmp.string(), std::ios::binary);
+        fs.write(reinterpret_cast<char const *>(&header), sizeof(header));
+        fs.write(data_.data(), data_.size());
+        fs.close();
+
+        if( !fs )
+        {
+            throw std::system_error(errno, std::system_category(), tmp.string());
+        }
+
+        boost::filesystem::rename(tmp, file);
+    }
+
+private:
+    std::string data_;
+};
+
+class ResultsReader
+{
+public:
+    explicit ResultsReader(path const & file) : file_(file)
+    {
+        int err = read_file(file, data_);
+        if( err )
+        {
+            throw IOStreamError( file, std::system_error(err, std::system_category()) );
+        }
+
+        if( data_.size() < sizeof(header_) ) invalid();
+        std::memcpy(&header_, data_.data(), sizeof(header_));
+
+        if( !std::equal(RESULTS_MAGIC, RESULTS_MAGIC + 8, header_.magic) ) invalid();
+        if( header_.version != RESULTS_VERSION ) invalid();
+        if( header_.check_count != CHECK_COUNT ) invalid();
+        if( header_.size != data_.size() ) invalid();
+        if( header_.shard == 0 || header_.shard > header_.shards ) invalid();
+
+        if( header_.checksum != fnv1a(data_.data() + sizeof(header_), 
+            data_.size() - sizeof(header_)) ) invalid();
+
+        next_ = sizeof(header_);
+    }
+
+    ResultsHeader const & header() const
+    {
+        return header_;
+    }
+
+    [[noreturn]] void invalid() const
+    {
+        throw std::runtime_error("invalid results file: " + file_.string());
+    }
+
+    uint32_t get()
+    {
+        uint32_t n;
+        if( data_.size() - next_ < sizeof(n) ) invalid();
+        std::memcpy(&n, data_.data() + next_, sizeof(n));
+        next_ += sizeof(n);
+        return n;
+    }
+
+    wstring get_string()
+    {
+        uint32_t size = get();
+        if( data_.size() - next_ < size ) invalid();
+
+        wstring s = wide_from_utf8(data_.data() + next_, size);
+        next_ += size;
+        return s;
+    }
+
+private:
+    path file_;
+    std::string data_;
+    ResultsHeader header_;
+    std::size_t next_ = 0;
+};
+
+
+///////////////////////////////////////////////////////////////////////
+
+void print_tag_table(std::wostream & out, wstring const & name, 
+    map<wstring, int> const & tags)
+{
+    out << name << ":\n";
+    if( tags.empty() )
+    {
+        out << L"  <no tags>\n";
+    }
+    else
+    {
+        for(auto const & t: tags) 
+        {
+            out << "  ";
+            out << std::setw(20) <<std:: left << t.first; 
+            out << std::setw(4) << std::right << t.second;
+            out << '\n';
+        }
+    }
+}
+
+/*
+The tags report.  Tags that are also a sphere of life or a project
+somewhere are left out of the tags, whatever the order of the notes:
+the report is the same for any listing, or any split of it.
+*/
+void print_tags_report(std::wostream & out, map<wstring, int> const & spheres,
+    map<wstring, int> const & projects, map<wstring, int> const & tags)
+{
+    map<wstring, int> others;
+    for(auto const & t: tags)
+    {
+        if( !spheres.count(t.first) && !projects.count(t.first) ) others.insert(t);
+    }
+
+    print_tag_table(out, L"Sphere of life", spheres);
+    out << '\n';
+    print_tag_table(out, L"Project", projects);
+    out << '\n';
+    print_tag_table(out, L"Tags", others);
+}
+
+class BaseDirectoryVisitor : public DirectoryVisitor
+{
+public:
+    explicit BaseDirectoryVisitor(std::wostream & out = wcout) : out_(out) {}
+
+    virtual bool file(File const & file)
+    {
+        return note(load_note(file));
+    }
+
+    // Visits a note that is already in memory (kept by the server).
+    bool loaded(Note const & loaded_note)
+    {
+        accumulate_tags(loaded_note);
+        return note(loaded_note);
+    }
+
+    void print_tags()
+    {
+        print_tags_report(out_, sphere_tags, project_tags, tags);
+    }
+
+    void save_tags(ResultsWriter & results) const
+    {
+        for(auto counts: {&sphere_tags, &project_tags, &tags})
+        {
+            results.put( uint32_t(counts->size()) );
+            for(auto const & t: *counts)
+            {
+                results.put(t.first);
+                results.put( uint32_t(t.second) );
+            }
+        }
+    }
+
+    void add_tags(BaseDirectoryVisitor const & other)
+    {
+        for(auto const & t: other.sphere_tags ) sphere_tags [t.first] += t.second;
+        for(auto const & t: other.project_tags) project_tags[t.first] += t.second;
+        for(auto const & t: other.tags        ) tags        [t.first] += t.second;
+    }
+
+    // Adds the counts of a shard, saved by save_tags().
+    void merge_tags(ResultsReader & results)
+    {
+        for(auto counts: {&sphere_tags, &project_tags, &tags})
+        {
+            uint32_t n = results.get();
+            for(uint32_t i = 0; i != n; ++i)
+            {
+                wstring tag = results.get_string();
+                (*counts)[tag] += results.get();
+            }
+        }
+    }
+
+protected:
+    virtual bool note(Note const &)
+    {
+        return true;
+    }
+
+    Note load_note(File const & file)
+    {
+        Note note(file);
+
+        accumulate_tags(note);
+
+        return note;
+    }
+
+    std::wostream & out_;
+
+    // One entry per note: only for the visitors that query it.
+    bool index_tags = false;
+    TagIndex tag_index;
+
+    map< wstring, int > sphere_tags;
+    map< wstring, int > project_tags;
+    map< wstring, int > tags;   // all of them, see print_tags_report()
+
+private:
+    void accumulate_tags(Note const & note)
+    {
+        if( index_tags ) tag_index.add(note);
+
+        if( note.name.sphere  ) ++  sphere_tags[*note.name. sphere] ;
+        if( note.name.project ) ++ project_tags[*note.name.project] ;
+
+        for(wstring const & tag: note.tags) ++ tags[tag] ;
+    }
+};
+
+
+
+/*
+Options of the commands that scan the notes.  With a memory ceiling, 
+files wait to be loaded by batches instead of all together.
+*/
+class ScanOptions
+{
+public:
+    std::size_t max_memory = 0; // bytes, 0 for no ceiling
+    bool stats = false;
+
+    // Only the notes changed in git: since a revision, or staged.
+    optional<std::string> since;
+    bool staged = false;
+
+    bool incremental() const
+    {
+        return since || staged;
+    }
+
+    // Only a shard of the notes, 1 to shards, with its results saved
+    // in output instead of reported.
+    uint32_t shard = 0;
+    uint32_t shards = 0;
+    path output;
+
+    bool sharded() const
+    {
+        return shards != 0;
+    }
+
+    // By the name in the root: the same wherever the root is.
+    bool in_shard(path const & p) const
+    {
+        return !sharded() || xxhash64(p.filename().string()) % shards == shard - 1;
+    }
+
+    // At a rough 4 KiB a file: its paths, its note in the pipeline
+    // and its results.
+    std::size_t batch_size() const
+    {
+        if( max_memory == 0 ) return std::numeric_limits<std::size_t>::max();
+        return std::max<std::size_t>(64, max_memory / 4096);
+    }
+};
+
+/*
+"--stats", "--max-memory SIZE", where SIZE is in bytes or has a K,
+M or G suffix, "--shard I/N" or "--output FILE".  Returns false if 
+args[i] is not one of them or its value is invalid, otherwise moves 
+i to the last argument used.
+*/
+bool parse_scan_option(vector<wstring> const & args, std::size_t & i, 
+    ScanOptions & options)
+{
+    if( args[i] == L"--stats" )
+    {
+        options.stats = true;
+        return true;
+    }
+
+    if( args[i] == L"--output" && i + 1 != args.size() )
+    {
+        options.output = args[++i];
+        return true;
+    }
+
+    if( args[i] == L"--shard" && i + 1 != args.size() )
+    {
+        unsigned shard = 0;
+        unsigned shards = 0;
+        wchar_t end = 0;
+
+        if( std::swscanf(args[i + 1].c_str(), L"%u/%u%lc", &shard, &shards, &end) != 2 ||
+            shard == 0 || shard > shards )
+        {
+            return false;
+        }
+
+        options.shard = shard;
+        options.shards = shards;
+        ++i;
+        return true;
+    }
+
+    if( args[i] != L"--max-memory" || i + 1 == args.size() ) return false;
+
+    wstring const & size = args[i + 1];
+    wchar_t * end = nullptr;
+    unsigned long long n = std::wcstoull(size.c_str(), &end, 10);
+
+    wstring suffix(end);
+    if     ( suffix == L"K" ) n <<= 10;
+    else if( suffix == L"M" ) n <<= 20;
+    else if( suffix == L"G" ) n <<= 30;
+    else if( !suffix.empty() ) return false;
+
+    if( end == size.c_str() || n == 0 ) return false;
+
+    options.max_memory = n;
+    ++i;
+    return true;
+}
+
+/*
+Passes on to a visitor only the notes, and the orphan directories, 
+of the shard of the scan options.
+*/
+class ShardVisitor : public DirectoryVisitor
+{
+public:
+    ShardVisitor(DirectoryVisitor & visitor, ScanOptions const & scan)
+        : visitor_(visitor), scan_(scan) {}
+
+    virtual bool directory(path dir)
+    {
+        return !scan_.in_shard(dir) || visitor_.directory(dir);
+    }
+
+    virtual bool file(File const & file)
+    {
+        return !scan_.in_shard(file.filename) || visitor_.file(file);
+    }
+
+    virtual void skipped(path const & filename)
+    {
+        if( scan_.in_shard(filename) ) visitor_.skipped(filename);
+    }
+
+private:
+    DirectoryVisitor & visitor_;
+    ScanOptions const & scan_;
+};
+
+// Prints the figures of "--stats", the peak memory use included.
+void print_stats(std::wostream & out, std::size_t notes, 
+    optional<std::size_t> unchanged = boost::none)
+{
+    rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+
+    out << "\nStats:\n";
+    out << "  " << std::setw(24) << std::left << "notes";
+    out << std::setw(10) << std::right << notes << '\n';
+
+    if( unchanged )
+    {
+        out << "  " << std::setw(24) << std::left << "unchanged and clean";
+        out << std::setw(10) << std::right << *unchanged << '\n';
+    }
+
+    out << "  " << std::setw(24) << std::left << "peak memory (KiB)";
+    out << std::setw(10) << std::right << usage.ru_maxrss << '\n';
+}
+
+/*
+Collects the warnings and reports them once all notes are checked,
+sorted, so the report does not depend on the listing order.
+
+Notes given to file() are loaded and checked by report() or once 
+max_pending of them are waiting, on all processors.  Each note has 
+its own slot for its warnings: the workers share nothing.  What is
+kept of the warnings is interned, most messages are the same.
+*/
+class WarningVisitor : public BaseDirectoryVisitor
+{
+public:
+    enum Grouping { BY_FILE, BY_CHECK, BY_TAG };
+
+    explicit WarningVisitor(std::wostream & out = wcout, 
+        Grouping grouping = BY_FILE, bool summary = false,
+        std::size_t max_pending = std::numeric_limits<std::size_t>::max())
+        : BaseDirectoryVisitor(out), grouping_(grouping), summary_(summary),
+          max_pending_(max_pending)
+    {}
+
+    virtual bool directory(path dir)
+    {
+        orphans_.push_back(dir);
+        return true;
+    }
+
+    virtual bool file(File const & file)
+    {
+        names_.push_back(file.filename);
+        visited_.push_back(true);
+
+        Pending p{file, 0, 0};
+
+        if( store_ )
+        {
+            p.mtime = mtime_of(file.filename, &p.size);
+
+            if( store_->unchanged(file, p.mtime, p.size, CleanStore::CHECKED) )
+            {
+                ++checked_;
+                ++unchanged_;
+                return true;
+            }
+        }
+
+        pending_.push_back(p);
+        if( pending_.size() >= max_pending_ ) check_pending({this});
+        return true;
+    }
+
+    // Only named: their names are still compared to the visited ones.
+    virtual void skipped(path const & filename)
+    {
+        names_.push_back(filename);
+        visited_.push_back(false);
+    }
+
+    // Skips the notes the store knows clean, and keeps it up to date.
+    void remember(CleanStore & store)
+    {
+        store_ = &store;
+    }
+
+    // The notes checked so far.
+    std::size_t checked() const
+    {
+        return checked_;
+    }
+
+    // Of them, those skipped because the store knows them clean.
+    std::size_t unchanged() const
+    {
+        return unchanged_;
+    }
+
+    /*
+    Checks the notes given to file() of several visitors in one
+    parallel pass, for instance one visitor per notes root.
+    */
+    static void check_pending(vector<WarningVisitor *> const & visitors)
+    {
+        vector< std::pair<WarningVisitor *, Pending const *> > all;
+        for(auto v: visitors)
+        {
+            for(auto const & p: v->pending_) all.emplace_back(v, &p);
+        }
+
+        vector<File const *> files;
+        for(auto const & a: all) files.push_back(&a.second->file);
+
+        vector<NoteWarnings> results(all.size());
+
+        load_pipeline(files, [&](std::size_t i, Note const & note)
+        {
+            CleanStore const * store = all[i].first->store_;
+
+            if( store && store->same_content(note.file, note.content_hash, CleanStore::CHECKED) )
+            {
+                results[i].loaded = true;
+                results[i].unchanged = true;
+                results[i].hash = note.content_hash;
+            }
+            else
+            {
+                results[i] = check_note(note);
+            }
+        });
+
+        for(std::size_t i = 0; i != all.size(); ++i)
+        {
+            WarningVisitor * v = all[i].first;
+
+            v->add(results[i]);
+            if( v->store_ && results[i].loaded ) v->remember(*all[i].second, results[i]);
+            if( results[i].unchanged ) ++v->unchanged_;
+
+            results[i] = NoteWarnings();
+        }
+
+        for(auto v: visitors) 
+        {
+            v->checked_ += v->pending_.size();
+            v->pending_.clear();
+            v->pending_.shrink_to_fit();
+        }
+    }
+
+    void report()
+    {
+        check_pending({this});
+        check_unique();
+
+        std::sort(orphans_.begin(), orphans_.end());
+        for(auto const & dir: orphans_)
+        {
+            out_ << "warning: orphan directory found: " << dir.wstring() << '\n';
+        }
+
+        std::sort(warnings_.begin(), warnings_.end(), 
+            [&](Warning const & a, Warning const & b)
+            {
+                path const & fa = notes_[a.note].filename;
+                path const & fb = notes_[b.note].filename;
+                if( fa != fb ) return fa < fb;
+                return a.check < b.check;
+            });
+
+        switch( grouping_ )
+        {
+        case BY_FILE:  report_by_file();  break;
+        case BY_CHECK: report_by_check(); break;
+        case BY_TAG:   report_by_tag();   break;
+        }
+
+        if( summary_ ) report_summary();
+    }
+
+    // The warnings, unsorted, for a merge of the shards.
+    void save(ResultsWriter & results)
+    {
+        check_pending({this});
+
+        results.put( uint32_t(strings_.size()) );
+        for(auto const & s: strings_) results.put(s);
+
+        results.put( uint32_t(orphans_.size()) );
+        for(auto const & dir: orphans_) results.put(dir.wstring());
+
+        results.put( uint32_t(names_.size()) );
+        for(std::size_t i = 0; i != names_.size(); ++i)
+        {
+            results.put(names_[i].wstring());
+            results.put( uint32_t(visited_[i]) );
+        }
+
+        results.put( uint32_t(notes_.size()) );
+        for(auto const & note: notes_)
+        {
+            results.put(note.filename.wstring());
+            results.put( uint32_t(note.tags.size()) );
+            for(auto tag: note.tags) results.put(tag);
+        }
+
+        results.put( uint32_t(warnings_.size()) );
+        for(auto const & w: warnings_)
+        {
+            results.put(w.note);
+            results.put(w.check);
+            results.put(w.message);
+        }
+    }
+
+    // Adds the warnings of a shard, saved by save().
+    void merge(ResultsReader & results)
+    {
+        vector<uint32_t> ids(results.get());
+        for(auto & id: ids) id = intern(results.get_string());
+
+        auto string_id = [&](uint32_t i)
+        {
+            if( i >= ids.size() ) results.invalid();
+            return ids[i];
+        };
+
+        uint32_t orphans = results.get();
+        for(uint32_t i = 0; i != orphans; ++i) orphans_.push_back(results.get_string());
+
+        uint32_t names = results.get();
+        for(uint32_t i = 0; i != names; ++i) 
+        {
+            names_.push_back(results.get_string());
+            visited_.push_back(results.get() != 0);
+        }
+
+        uint32_t first = notes_.size();
+        uint32_t notes = results.get();
+        for(uint32_t i = 0; i != notes; ++i)
+        {
+            notes_.push_back( NoteInfo{results.get_string(), {}} );
+            uint32_t tags = results.get();
+            for(uint32_t t = 0; t != tags; ++t) 
+                notes_.back().tags.push_back( string_id(results.get()) );
+        }
+
+        uint32_t warnings = results.get();
+        for(uint32_t i = 0; i != warnings; ++i)
+        {
+            uint32_t note = results.get();
+            uint32_t check = results.get();
+            uint32_t message = string_id(results.get());
+
+            if( note >= notes || check >= CHECK_COUNT ) results.invalid();
+            warnings_.push_back( Warning{first + note, CheckId(check), message} );
+        }
+    }
+
+protected:
+    virtual bool note(Note const & note)
+    {
+        // Kept by the server: already loaded, nothing to gain 
+        // from threads.
+        names_.push_back(note.file.filename);
+        visited_.push_back(true);
+
+        NoteWarnings w = check_note(note);
+        add(w);
+        ++checked_;
+        return true;
+    }
+
+private:
+    struct Warning
+    {
+        uint32_t note;
+        CheckId check;
+        uint32_t message;   // interned
+    };
+
+    struct NoteInfo
+    {
+        path filename;
+        vector<uint32_t> tags; // interned, of the filename then of the header
+    };
+
+    struct NoteWarnings
+    {
+        path filename;
+        vector<wstring> tags;
+        vector< std::pair<CheckId, wstring> > warnings;
+
+        // For the store.
+        bool loaded = false;
+        bool unchanged = false;     // clean, not checked again
+        bool remember = false;      // clean, and can be remembered so
+        bool links = false;
+        uint64_t hash = 0;
+    };
+
+    struct Pending
+    {
+        File file;
+        int64_t mtime;  // with a store only
+        uint64_t size;
+    };
+
+    static NoteWarnings check_note(Note const & note)
+    {
+        NoteWarnings r;
+
+        for_each_check( [&](auto t)
+        {
+            typedef typename decltype(t)::type CheckType;
+
+            CheckType check(note);
+            if( !check ) r.warnings.emplace_back(CheckType::id, check.message());
+        });
+
+        r.loaded = true;
+        r.hash = note.content_hash;
+        r.links = !note.links.empty();
+        r.remember = r.warnings.empty() && checks_can_be_remembered(note);
+
+        if( !r.warnings.empty() )
+        {
+            r.filename = note.file.filename;
+            if( note.name.sphere  ) r.tags.push_back(*note.name.sphere );
+            if( note.name.project ) r.tags.push_back(*note.name.project);
+            for(auto const & tag: note.tags)
+            {
+                if( boost::range::count(r.tags, tag) == 0 ) r.tags.push_back(tag);
+            }
+        }
+
+        return r;
+    }
+
+    void add(NoteWarnings const & w)
+    {
+        if( w.warnings.empty() ) return;
+
+        uint32_t id = notes_.size();
+        notes_.push_back( NoteInfo{w.filename, {}} );
+        for(auto const & tag: w.tags) notes_.back().tags.push_back( intern(tag) );
+
+        for(auto const & warning: w.warnings)
+        {
+            warnings_.push_back( Warning{id, warning.first, intern(warning.second)} );
+        }
+    }
+
+    /*
+    The checks across the notes: notes with the same subject, and file
+    names that differ only by case or accents, which clash on file
+    systems that ignore them.  Both compare fold()ed keys, so they also
+    catch the same accented letter composed or decomposed.
+
+    Each thread groups a slice of the notes by key in its own hash 
+    tables, merged once all are done: one pass, no lock.  The notes are
+    compared by their file names only, so the notes the store skips 
+    still count.  With --since or --staged, all the notes listed are
+    compared, but only the groups of a changed note are reported.
+    */
+    void check_unique()
+    {
+        typedef std::unordered_map< wstring, vector<uint32_t> > Groups;
+
+        std::size_t slices = std::max(1u, std::thread::hardware_concurrency());
+        vector<Groups> subjects(slices);
+        vector<Groups> filenames(slices);
+        vector<Name> parsed(names_.size());
+
+        parallel_for(slices, [&](std::size_t t)
+        {
+            for(std::size_t i = t; i < names_.size(); i += slices)
+            {
+                filenames[t][ fold(names_[i].filename().wstring()) ].push_back(i);
+
+                if( parse_filename(File(names_[i]), parsed[i]) )
+                    subjects[t][ fold(*parsed[i].subject) ].push_back(i);
+            }
+        });
+
+        for(std::size_t t = 1; t < slices; ++t)
+        {
+            merge_groups(subjects[0], subjects[t]);
+            merge_groups(filenames[0], filenames[t]);
+        }
+
+        add_collisions(subjects[0], DUPLICATE_SUBJECT_CHECK, L"same subject as ", parsed);
+        add_collisions(filenames[0], FILENAME_CLASH_CHECK, L"filename clashes with ", parsed);
+    }
+
+    template <typename Groups>
+    static void merge_groups(Groups & into, Groups & from)
+    {
+        for(auto & g: from)
+        {
+            auto & ids = into[g.first];
+            ids.insert(ids.end(), g.second.begin(), g.second.end());
+        }
+        from = Groups();
+    }
+
+    template <typename Groups>
+    void add_collisions(Groups const & groups, CheckId check, 
+        wchar_t const * message, vector<Name> const & parsed)
+    {
+        for(auto const & g: groups)
+        {
+            if( g.second.size() < 2 ) continue;
+            if( std::none_of(g.second.begin(), g.second.end(), 
+                    [&](uint32_t i) { return visited_[i]; }) ) continue;
+
+            // By name: the same for any number of threads or shards.
+            vector<uint32_t> ids = g.second;
+            std::sort(ids.begin(), ids.end(), [&](uint32_t a, uint32_t b)
+            {
+                return names_[a] < names_[b];
+            });
+
+            for(auto i: ids)
+            {
+                std::wostringstream os;
+                os << message;
+
+                char const * sep = "";
+                for(auto other: ids)
+                {
+                    if( other == i ) continue;
+                    os << sep << '"' << names_[other].filename().wstring() << '"';
+                    sep = ", ";
+                }
+
+                NoteWarnings w;
+                w.filename = names_[i];
+                if( parsed[i].sphere  ) w.tags.push_back(*parsed[i].sphere );
+                if( parsed[i].project ) w.tags.push_back(*parsed[i].project);
+                w.warnings.emplace_back(check, os.str());
+                add(w);
+            }
+        }
+    }
+
+    void remember(Pending const & p, NoteWarnings const & w)
+    {
+        if( w.unchanged )
+        {
+            store_->touch(p.file, p.mtime, p.size);
+        }
+        else if( w.remember )
+        {
+            store_->mark(p.file, w.hash, p.mtime, p.size, CleanStore::CHECKED,
+                check_context(p.file, w.links), w.links);
+        }
+        else
+        {
+            store_->unmark(p.file, CleanStore::CHECKED);
+        }
+    }
+
+    uint32_t intern(wstring const & s)
+    {
+        auto it = string_ids_.find(s);
+        if( it != string_ids_.end() ) return it->second;
+
+        strings_.push_back(s);
+        string_ids_.emplace(strings_.back(), strings_.size() - 1);
+        return strings_.size() - 1;
+    }
+
+    void print(Warning const & w)
+    {
+        out_ << "warning(" << notes_[w.note].filename.wstring() << "): ";
+        out_ << strings_[w.message] << '\n';
+    }
+
+    void report_by_file()
+    {
+        for(auto const & w: warnings_) print(w);
+    }
+
+    void report_by_check()
+    {
+        for(int c = 0; c != CHECK_COUNT; ++c)
+        {
+            bool first = true;
+            for(auto const & w: warnings_)
+            {
+                if( w.check != c ) continue;
+
+                if( first ) out_ << '\n' << check_name(w.check) << ":\n";
+                first = false;
+
+                out_ << "  ";
+                print(w);
+            }
+        }
+    }
+
+    void report_by_tag()
+    {
+        map< wstring, vector<Warning const *> > by_tag;
+
+        for(auto const & w: warnings_)
+        {
+            auto const & tags = notes_[w.note].tags;
+            if( tags.empty() ) by_tag[L"<no tags>"].push_back(&w);
+            for(auto tag: tags) by_tag[strings_[tag]].push_back(&w);
+        }
+
+        for(auto const & t: by_tag)
+        {
+            out_ << '\n' << t.first << ":\n";
+            for(auto w: t.second)
+            {
+                out_ << "  ";
+                print(*w);
+            }
+        }
+    }
+
+    void report_summary()
+    {
+        vector<int> counts(CHECK_COUNT);
+        for(auto const & w: warnings_) ++counts[w.check];
+
+        out_ << "\nSummary:\n";
+        out_ << "  " << std::setw(24) << std::left << "orphan_directory";
+        out_ << std::setw(6) << std::right << orphans_.size() << '\n';
+
+        for(int c = 0; c != CHECK_COUNT; ++c)
+        {
+            out_ << "  " << std::setw(24) << std::left << check_name(CheckId(c));
+            out_ << std::setw(6) << std::right << counts[c] << '\n';
+        }
+    }
+
+    Grouping grouping_;
+    bool summary_;
+    std::size_t max_pending_;
+
+    vector<Pending> pending_;
+    std::size_t checked_ = 0;
+    std::size_t unchanged_ = 0;
+    CleanStore * store_ = nullptr;
+    vector<path> orphans_;
+    vector<path> names_;    // of every note listed, for check_unique()
+    vector<bool> visited_;  // by names_, false when only skipped()
+
+    vector<NoteInfo> notes_; // with warnings
+    vector<Warning> warnings_;
+
+    std::deque<wstring> strings_;   // do not move, string_ids_ points to them
+    std::unordered_map<std::wstring_view, uint32_t> string_ids_;
+};
+
+/*
+Arguments of "check": [--group-by file|check|tag] [--summary] 
+[--max-memory SIZE] [--stats] [--since REV | --staged] [ROOT...].
+The scan options and roots are only accepted if asked for.  Returns
+false on an invalid option.
+*/
+bool parse_check_options(vector<wstring> const & args,
+    WarningVisitor::Grouping & grouping, bool & summary,
+    vector<path> * roots = nullptr, ScanOptions * scan = nullptr)
+{
+    grouping = WarningVisitor::BY_FILE;
+    summary = false;
+
+    for(std::size_t i = 0; i != args.size(); ++i)
+    {
+        if( roots && !boost::algorithm::starts_with(args[i], L"--") )
+        {
+            roots->push_back(args[i]);
+        }
+        else if( args[i] == L"--summary" )
+        {
+            summary = true;
+        }
+        else if( args[i] == L"--group-by" && i + 1 != args.size() )
+        {
+            wstring g = args[++i];
+            if     ( g == L"file"  ) grouping = WarningVisitor::BY_FILE;
+            else if( g == L"check" ) grouping = WarningVisitor::BY_CHECK;
+            else if( g == L"tag"   ) grouping = WarningVisitor::BY_TAG;
+            else return false;
+        }
+        else if( scan && args[i] == L"--staged" )
+        {
+            scan->staged = true;
+        }
+        else if( scan && args[i] == L"--since" && i + 1 != args.size() )
+        {
+            scan->since = narrow(args[++i]);
+        }
+        else if( scan && parse_scan_option(args, i, *scan) )
+        {
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+class PrintTagsVisitor : public BaseDirectoryVisitor
+{
+public:
+    explicit PrintTagsVisitor(std::wostream & out = wcout)
+        : BaseDirectoryVisitor(out) {}
+
+    virtual bool directory(path)
+    {
+        return true;
+    }
+};
+
+class QueryVisitor : public BaseDirectoryVisitor
+{
+public:
+    QueryVisitor()
+    {
+        index_tags = true;
+    }
+
+    virtual bool directory(path)
+    {
+        return true;
+    }
+
+    void print_notes(wstring const & expression)
+    {
+        tag_index.query(expression).for_each( [&](uint32_t id)
+        {
+            out_ << tag_index.filename(id).wstring() << '\n';
+        });
+    }
+
+    // How many of the matching notes carry each tag.
+    void print_cooccurrences(wstring const & expression)
+    {
+        TagBitmap notes = tag_index.query(expression);
+
+        map<wstring, int> counts;
+        for(auto const & t: tag_index.bitmaps())
+        {
+            std::size_t n = (t.second & notes).count();
+            if( n ) counts[t.first] = n;
+        }
+
+        print_tag_table(out_, L"Co-occurring tags", counts);
+    }
+};
+
+/*
+Writes one JSON object per note, on one line, as soon as the note 
+is parsed.  Nothing is kept from one note to the next.
+*/
+class ExportVisitor : public BaseDirectoryVisitor
+{
+public:
+    ExportVisitor(std::ostream & os, bool with_body) 
+        : os_(os), with_body_(with_body) {}
+
+    virtual bool directory(path)
+    {
+        return true;
+    }
+
+    virtual bool file(File const & file)
+    {
+        // Not load_note(): no tag accounting, memory stays flat.
+        Note note(file);
+
+        os_ << "{\"path\":" << json_string(note.file.filename.wstring());
+
+        os_ << ",\"name\":{\"sphere\":" << json_string(note.name.sphere);
+        os_ << ",\"project\":" << json_string(note.name.project);
+        os_ << ",\"subject\":" << json_string(note.name.subject) << '}';
+
+        os_ << ",\"annex\":";
+        if( note.file.annex.empty() )
+        {
+            os_ << "null";
+        }
+        else
+        {
+            AnnexStats const & stats = note.file.annex_stats;
+            os_ << "{\"path\":" << json_string(note.file.annex.wstring());
+            os_ << ",\"entries\":" << stats.entries;
+            os_ << ",\"size\":" << stats.size;
+            os_ << ",\"newest\":" << stats.newest << '}';
+        }
+
+        os_ << ",\"header\":{";
+        char const * sep = "";
+        for(auto const & field: note.header)
+        {
+            os_ << sep << json_string(field.first) << ':' << json_string(field.second);
+            sep = ",";
+        }
+
+        os_ << "},\"tags\":[";
+        sep = "";
+        for(auto const & tag: note.tags)
+        {
+            os_ << sep << json_string(tag);
+            sep = ",";
+        }
+
+        os_ << "],\"failures\":[";
+        sep = "";
+        for_each_check( [&](auto t)
+        {
+            typedef typename decltype(t)::type CheckType;
+
+            CheckType check(note);
+            if( !check )
+            {
+                os_ << sep << "{\"check\":\"" << check_name(CheckType::id);
+                os_ << "\",\"message\":" << json_string(check.message()) << '}';
+                sep = ",";
+            }
+        });
+        os_ << ']';
+
+        if( with_body_ ) os_ << ",\"body\":" << json_string(note.body);
+
+        // A blocked reader blocks this write: the scan goes at
+        // the pace of the pipeline.
+        os_ << "}\n";
+
+        return os_.good();
+    }
+
+private:
+    std::ostream & os_;
+    bool with_body_;
+};
+
+/*
+The files a scan would load, without loading them.  Given a batch
+size, the files are handed to full() by batches of that size instead, 
+the last batch is left in files.
+*/
+class FileListVisitor : public DirectoryVisitor
+{
+public:
+    FileListVisitor() {}
+
+    FileListVisitor(std::size_t batch, std::function<void (vector<File> &)> full)
+        : batch_(batch), full_(full) {}
+
+    virtual bool directory(path)
+    {
+        return true;
+    }
+
+    virtual bool file(File const & file)
+    {
+        files.push_back(file);
+
+        if( files.size() >= batch_ )
+        {
+            full_(files);
+            files.clear();
+        }
+
+        return true;
+    }
+
+    vector<File> files;
+
+private:
+    std::size_t batch_ = std::numeric_limits<std::size_t>::max();
+    std::function<void (vector<File> &)> full_;
+};
+
+class SearchVisitor : public BaseDirectoryVisitor
+{
+public:
+    SearchVisitor(wstring const & term, std::wostream & out = wcout)
+        : BaseDirectoryVisitor(out), term_(term) {}
+
+    virtual bool directory(path)
+    {
+        return true;
+    }
+
+protected:
+    virtual bool note(Note const & note)
+    {
+        // Like search_notes: hits in the file name, then in the contents.
+        wstring fn = note.file.filename.filename().wstring();
+
+        if( boost::algorithm::contains(fn, term_) ||
+            boost::algorithm::contains(note.text, term_) )
+        {
+            out_ << note.file.filename.wstring() << '\n';
+        }
+
+        return true;
+    }
+
+private:
+    wstring term_;
+};
+
+/*
+Repairs the notes interactively.  A prefetch thread lists, reads and
+diagnoses the notes ahead of the prompts, so that the next finding is
+ready when the user answers; the notes without CRs are parsed in
+memory, for when the EOL repair is accepted.  The repaired notes are
+written by a writer thread, in order.
+*/
+class HealerVisitor : public BaseDirectoryVisitor
+{
+    struct quit_signal {};
+
+    // A note with its findings, as the prefetch thread leaves it.
+    struct Diagnosis
+    {
+        struct Variant
+        {
+            Variant(File const & file, std::string const & bytes)
+                : note(file, bytes), eol(note), subject(note), tags(note) {}
+
+            Note note;
+            EolHealer eol;
+            SubjectFieldHealer subject;
+            TagsFieldHealer tags;
+        };
+
+        File file;
+        int64_t mtime = 0;
+        uint64_t size = 0;
+
+        std::unique_ptr<Variant> read;
+        std::unique_ptr<Variant> stripped;     // if read has CRs
+
+        Note * repaired = nullptr;              // the variant to write
+        bool rewrite = false;                   // else, only strip the CRs
+    };
+
+    typedef std::unique_ptr<Diagnosis> DiagnosisPtr;
+
+public:
+    HealerVisitor() : diagnoses_(LOOKAHEAD), repairs_(LOOKAHEAD) {}
+
+    /*
+    Whatever stops it, quitting or an error, both threads are closed
+    and joined before it returns or throws.
+    */
+    void run(path const & root)
+    {
+        std::exception_ptr prefetch_error;
+        std::exception_ptr prompt_error;
+
+        std::thread writer([&]() { write_repairs(); });
+
+        std::thread prefetch;
+        try
+        {
+            prefetch = std::thread([&]()
+            {
+                try
+                {
+                    visit(root, *this);
+                }
+                catch(...)
+                {
+                    prefetch_error = std::current_exception();
+                }
+
+                diagnoses_.close();
+            });
+        }
+        catch(...)
+        {
+            repairs_.close();
+            writer.join();
+            throw;
+        }
+
+        DiagnosisPtr diagnosis;
+
+        // Lets the prefetch thread see it before its next note.
+        auto stop = [&]()
+        {
+            stop_ = true;
+            while( diagnoses_.pop(diagnosis) ) {}
+        };
+
+        while( diagnoses_.pop(diagnosis) )
+        {
+            try
+            {
+                prompt( std::move(diagnosis) );
+            }
+            catch(quit_signal const &)
+            {
+                stop();
+            }
+            catch(...)
+            {
+                prompt_error = std::current_exception();
+                stop();
+            }
+        }
+
+        prefetch.join();
+        repairs_.close();
+        writer.join();
+
+        if( prompt_error ) std::rethrow_exception(prompt_error);
+        if( prefetch_error ) std::rethrow_exception(prefetch_error);
+    }
+
+    virtual bool directory(path)
+    {
+        return true;
+    }
+
+    // On the prefetch thread.
+    virtual bool file(File const & file)
+    {
+        if( stop_ ) return false;
+
+        auto d = std::make_unique<Diagnosis>();
+        d->file = file;
+
+        if( store_ )
+        {
+            d->mtime = mtime_of(file.filename, &d->size);
+
+            std::lock_guard<std::mutex> lock(store_mutex_);
+            if( store_->unchanged(file, d->mtime, d->size, CleanStore::REPAIRED) ) return true;
+        }
+
+        std::string bytes;
+        int err = read_file(file.filename, bytes);
+        if( err )
+        {
+            throw IOStreamError( file.filename, 
+                std::system_error(err, std::system_category()) );
+        }
+
+        if( store_ )
+        {
+            std::lock_guard<std::mutex> lock(store_mutex_);
+            if( store_->same_content(file, xxhash64(bytes), CleanStore::REPAIRED) )
+            {
+                store_->touch(file, d->mtime, d->size);
+                return true;
+            }
+        }
+
+        d->read = std::make_unique<Diagnosis::Variant>(file, bytes);
+
+        if( !d->read->eol )
+        {
+            bytes = strip_cr(bytes);
+            d->stripped = std::make_unique<Diagnosis::Variant>(file, bytes);
+        }
+
+        diagnoses_.push( std::move(d) );
+        return true;
+    }
+
+    // Skips the notes the store knows need no repair, and keeps it 
+    // up to date.
+    void remember(CleanStore & store)
+    {
+        store_ = &store;
+    }
+
+private:
+    static constexpr std::size_t LOOKAHEAD = 64;
+
+    void prompt(DiagnosisPtr d)
+    {
+        offered_ = false;
+
+        auto * v = d->read.get();
+        bool eol = false;
+
+        try
+        {
+            if( offer(v->note, v->eol) )
+            {
+                eol = true;
+                v = d->stripped.get();
+            }
+
+            if( offer(v->note, v->subject) )
+            {
+                v->subject.heal();
+                d->rewrite = true;
+            }
+
+            if( offer(v->note, v->tags) )
+            {
+                v->tags.heal();
+                d->rewrite = true;
+            }
+        }
+        catch(quit_signal const &)
+        {
+            // The repairs accepted before quitting are still written.
+            queue_repair(std::move(d), v->note, eol);
+            throw;
+        }
+
+        if( store_ && !offered_ )
+        {
+            std::lock_guard<std::mutex> lock(store_mutex_);
+            store_->mark(d->file, v->note.content_hash, d->mtime, d->size, 
+                CleanStore::REPAIRED);
+        }
+
+        if( !is_all(input_) )
+        {
+            input_.clear();
+        }
+
+        queue_repair(std::move(d), v->note, eol);
+    }
+
+    void queue_repair(DiagnosisPtr d, Note & repaired, bool eol)
+    {
+        if( !eol && !d->rewrite ) return;
+
+        d->repaired = &repaired;
+        repairs_.push( std::move(d) );
+    }
+
+    // True if the user accepts the repair.
+    template <typename Healer>
+    bool offer(Note const & note, Healer const & h)
+    {
+        if( is_file_skip(input_) )
+        {
+            offered_ = true;
+            return false;
+        }
+
+        if( !h )
+        {
+            offered_ = true;
+
+            wcout << note.file.filename.wstring() << ": " << h.message() << '\n';
+
+            /*
+            yes - this file, this repair only
+            no - skip this file, this repair only
+            file - all repairs for this file only
+            skip - skip all repairs for this file only
+            all - all files, all repairs
+            quit
+            */
+
+            if( !is_all(input_) && !is_file_all_repairs(input_) )
+            {
+                wcout << "Repair? (y|[n]|file|skip|all|quit) " << std::flush;
+                getline(wcin, input_);
+            }
+
+            if( is_yes(input_) || is_file_all_repairs(input_) || is_all(input_) )
+            {
+                wcout << "REPAIRED!\n";
+                return true;
+            }
+            else if( is_quit(input_) )
+            {
+                throw quit_signal();
+            }
+        }
+        return false;
+    }
+
+    // On the writer thread: a failed write does not stop the others.
+    void write_repairs()
+    {
+        DiagnosisPtr d;
+        while( repairs_.pop(d) )
+        {
+            try
+            {
+                if( d->rewrite ) d->repaired->write();
+                else strip_cr(d->file.filename);
+            }
+            catch(std::exception const & error)
+            {
+                std::cerr << error.what() << "\n";
+            }
+        }
+    }
+
+    wstring input_;
+
+    CleanStore * store_ = nullptr;
+    std::mutex store_mutex_;
+    bool offered_ = false;  // a repair, for the current note
+
+    BoundedQueue<DiagnosisPtr> diagnoses_;
+    BoundedQueue<DiagnosisPtr> repairs_;
+    std::atomic<bool> stop_{false};
+};
+
+
+/*
+The links between the notes of a directory, for the "links" report.
+Notes and annexes are interned as they are met: an edge is a pair of
+ids.  Edges to an annex go to its note once all notes are added.
+*/
+class LinkGraph
+{
+public:
+    void add(Note const & note)
+    {
+        uint32_t from = intern(note.file.filename);
+        added_[from] = true;
+
+        if( !note.file.annex.empty() ) owners_[intern(note.file.annex)] = from;
+
+        if( !note.file.listing ) return;
+        Listing const & listing = *note.file.listing;
+
+        for(auto const & link: note.links)
+        {
+            ResolvedLink r = resolve_link(listing, link);
+
+            switch( r.kind )
+            {
+            case LINK_NOTE:
+            case LINK_ANNEX_FILE:
+            {
+                edges_.emplace_back(from, intern(listing.directory / r.name));
+                break;
+            }
+            case LINK_BROKEN:
+                broken_.emplace_back(from, link);
+                break;
+            case LINK_MISSING_ANNEX_FILE:
+                missing_.emplace_back(from, link);
+                break;
+            case LINK_OTHER:
+                break;
+            }
+        }
+    }
+
+    void print(std::wostream & out)
+    {
+        for(auto & e: edges_)
+        {
+            auto owner = owners_.find(e.second);
+            if( owner != owners_.end() ) e.second = owner->second;
+        }
+
+        edges_.erase( std::remove_if(edges_.begin(), edges_.end(), 
+            [](auto const & e) { return e.first == e.second; }), edges_.end() );
+        std::sort(edges_.begin(), edges_.end());
+        edges_.erase( std::unique(edges_.begin(), edges_.end()), edges_.end() );
+
+        vector<uint32_t> incoming(names_.size());
+        for(auto const & e: edges_) ++incoming[e.second];
+
+        out << "Notes: " << std::count(added_.begin(), added_.end(), true);
+        out << ", links between them: " << edges_.size() << '\n';
+
+        vector<uint32_t> most(names_.size());
+        for(uint32_t id = 0; id != most.size(); ++id) most[id] = id;
+        std::stable_sort(most.begin(), most.end(), [&](uint32_t a, uint32_t b)
+            { return std::tie(incoming[b], names_[a]) < std::tie(incoming[a], names_[b]); });
+
+        out << "\nMost linked:\n";
+        for(std::size_t i = 0; i != most.size() && i != 10 && incoming[most[i]]; ++i)
+        {
+            out << "  " << std::setw(6) << std::right << incoming[most[i]];
+            out << "  " << names_[most[i]].wstring() << '\n';
+        }
+
+        print_links(out, L"Broken links", broken_);
+        print_links(out, L"Missing annex files", missing_);
+
+        // Not linked from any other note.
+        set<path> orphans;
+        for(uint32_t id = 0; id != names_.size(); ++id)
+        {
+            if( added_[id] && incoming[id] == 0 ) orphans.insert(names_[id]);
+        }
+
+        out << "\nOrphan notes:\n";
+        for(auto const & o: orphans) out << "  " << o.wstring() << '\n';
+    }
+
+private:
+    uint32_t intern(path const & filename)
+    {
+        auto it = ids_.emplace(filename.wstring(), names_.size()).first;
+        if( it->second == names_.size() )
+        {
+            names_.push_back(filename);
+            added_.push_back(false);
+        }
+        return it->second;
+    }
+
+    void print_links(std::wostream & out, wstring const & title,
+        vector< std::pair<uint32_t, wstring> > links)
+    {
+        std::sort(links.begin(), links.end(), [&](auto const & a, auto const & b)
+            { return std::tie(names_[a.first], a.second) < std::tie(names_[b.first], b.second); });
+
+        out << '\n' << title << ":\n";
+        for(auto const & l: links)
+        {
+            out << "  " << names_[l.first].wstring() << ": \"" << l.second << "\"\n";
+        }
+    }
+
+    std::unordered_map<wstring, uint32_t> ids_;
+    vector<path> names_;
+    vector<bool> added_;    // a note of the scan, not only linked to
+    std::unordered_map<uint32_t, uint32_t> owners_; // annex -> note
+
+    vector< std::pair<uint32_t, uint32_t> > edges_;
+    vector< std::pair<uint32_t, wstring> > broken_;
+    vector< std::pair<uint32_t, wstring> > missing_;
+};
+
+class LinksVisitor : public BaseDirectoryVisitor
+{
+public:
+    virtual bool directory(path)
+    {
+        return true;
+    }
+
+    virtual bool file(File const & file)
+    {
+        // No tag accounting, the report is only about links.
+        graph.add( Note(file) );
+        return true;
+    }
+
+    LinkGraph graph;
+};
+
+///////////////////////////////////////////////////////////////////////
+
+/*
+Fuzzy lookup of notes by subject, sphere and project.
+
+Each note has a key: its folded sphere, project and subject (of the
+filename and of the "Sujet" header, when they differ).  Keys are 
+indexed by trigram; a query only looks at the notes sharing the most 
+trigrams with it, then ranks them by edit distance, as a substring 
+of the key, and by whether the query is a subsequence of the key.
+*/
+class FindIndex
+{
+public:
+    void add(path const & filename, optional<wstring> const & sphere,
+        optional<wstring> const & project, optional<wstring> const & subject,
+        optional<wstring> const & subject_field)
+    {
+        wstring key;
+        for(auto const & part: { sphere, project, subject })
+        {
+            if( part ) key += *part + L' ';
+        }
+        if( subject_field && subject_field != subject ) key += *subject_field;
+
+        key = fold( boost::algorithm::trim_copy(key) );
+
+        uint32_t id = keys_.size();
+        filenames_.push_back(filename);
+        keys_.push_back(key);
+
+        for_each_trigram(key, [&](uint64_t t)
+        {
+            auto & posting = trigrams_[t];
+            if( posting.empty() || posting.back() != id ) posting.push_back(id);
+        });
+    }
+
+    void add(Note const & note)
+    {
+        auto field = note.header.find(SUBJECT_FIELD_NAME);
+        optional<wstring> subject_field;
+        if( field != note.header.end() ) subject_field = field->second;
+
+        add(note.file.filename, note.name.sphere, note.name.project, 
+            note.name.subject, subject_field);
+    }
+
+    // The best matches first.
+    vector<path> find(wstring const & query, std::size_t max_results = 20) const
+    {
+        wstring q = fold(query);
+        if( q.empty() ) return vector<path>();
+
+        // Notes sharing trigrams with the query, most shared first.
+        vector<uint32_t> candidates;
+
+        if( q.size() < 3 )
+        {
+            for(uint32_t id = 0; id != keys_.size(); ++id) candidates.push_back(id);
+        }
+        else
+        {
+            std::unordered_map<uint32_t, uint32_t> shared;
+            for_each_trigram(q, [&](uint64_t t)
+            {
+                auto it = trigrams_.find(t);
+                if( it == trigrams_.end() ) return;
+                for(auto id: it->second) ++shared[id];
+            });
+
+            vector< std::pair<uint32_t, uint32_t> > by_count(shared.begin(), shared.end());
+            std::size_t n = std::min<std::size_t>(by_count.size(), MAX_CANDIDATES);
+            std::partial_sort(by_count.begin(), by_count.begin() + n, by_count.end(),
+                [](auto const & a, auto const & b) 
+                { return a.second != b.second ? a.second > b.second : a.first < b.first; });
+
+            for(std::size_t i = 0; i != n; ++i) candidates.push_back(by_count[i].first);
+        }
+
+        std::size_t max_distance = q.size() / 4;
+
+        struct Match
+        {
+            std::size_t distance;
+            bool subsequence;
+            uint32_t id;
+        };
+
+        vector<Match> matches;
+        for(auto id: candidates)
+        {
+            Match m{ substring_distance(q, keys_[id]), is_subsequence(q, keys_[id]), id };
+            if( m.distance <= max_distance || m.subsequence ) matches.push_back(m);
+        }
+
+        std::sort(matches.begin(), matches.end(), [&](Match const & a, Match const & b)
+        {
+            if( a.distance != b.distance ) return a.distance < b.distance;
+            if( a.subsequence != b.subsequence ) return a.subsequence;
+            if( keys_[a.id].size() != keys_[b.id].size() ) 
+                return keys_[a.id].size() < keys_[b.id].size();
+            return filenames_[a.id] < filenames_[b.id];
+        });
+
+        vector<path> r;
+        for(std::size_t i = 0; i != matches.size() && i != max_results; ++i)
+        {
+            r.push_back( filenames_[matches[i].id] );
+        }
+        return r;
+    }
+
+    // Fewest edits to turn the query into a substring of the key.
+    static std::size_t substring_distance(wstring const & query, wstring const & key)
+    {
+        vector<std::size_t> row(key.size() + 1, 0);
+
+        for(std::size_t i = 1; i <= query.size(); ++i)
+        {
+            std::size_t diagonal = row[0];
+            row[0] = i;
+
+            for(std::size_t j = 1; j <= key.size(); ++j)
+            {
+                std::size_t up = row[j];
+                row[j] = std::min({ up + 1, row[j - 1] + 1,
+                    diagonal + (query[i - 1] == key[j - 1] ? 0 : 1) });
+                diagonal = up;
+            }
+        }
+
+        return *std::min_element(row.begin(), row.end());
+    }
+
+    static bool is_subsequence(wstring const & query, wstring const & key)
+    {
+        auto k = key.begin();
+        for(wchar_t c: query)
+        {
+            k = std::find(k, key.end(), c);
+            if( k == key.end() ) return false;
+            ++k;
+        }
+        return true;
+    }
+
+private:
+    static constexpr std::size_t MAX_CANDIDATES = 2000;
+
+    template <typename Function>
+    static void for_each_trigram(wstring const & key, Function f)
+    {
+        wstring padded = L' ' + key + L' ';
+        for(std::size_t i = 0; i + 3 <= padded.size(); ++i)
+        {
+            f( uint64_t(padded[i]) << 42 | uint64_t(padded[i + 1]) << 21 | padded[i + 2] );
+        }
+    }
+
+    vector<path> filenames_;
+    vector<wstring> keys_;
+    std::unordered_map< uint64_t, vector<uint32_t> > trigrams_;
+};
+
+class FindVisitor : public BaseDirectoryVisitor
+{
+public:
+    virtual bool directory(path)
+    {
+        return true;
+    }
+
+    FindIndex index;
+
+protected:
+    virtual bool note(Note const & note)
+    {
+        index.add(note);
+        return true;
+    }
+};
+
+
+///////////////////////////////////////////////////////////////////////
+
+/*
+The notes of a directory, kept in memory by the server.
+
+Loading again only re-reads the notes that were invalidated
+(or are new), the others are kept as they were.
+*/
+class Vault : public DirectoryVisitor
+{
+public:
+    void load(path const & root)
+    {
+        previous_.clear();
+        for(auto & note: notes_)
+        {
+            path fn = note.file.filename;
+            previous_.emplace(fn, std::move(note));
+        }
+
+        notes_.clear();
+        orphans_.clear();
+
+        visit(root, *this);
+
+        previous_.clear();
+        stale_.clear();
+        everything_stale_ = false;
+    }
+
+    void invalidate(path const & filename)
+    {
+        stale_.insert(filename);
+    }
+
+    void invalidate()
+    {
+        everything_stale_ = true;
+    }
+
+    bool replay(BaseDirectoryVisitor & visitor) const
+    {
+        for(auto const & dir: orphans_)
+        {
+            if( !visitor.directory(dir) ) return false;
+        }
+
+        for(auto const & note: notes_)
+        {
+            if( !visitor.loaded(note) ) return false;
+        }
+
+        return true;
+    }
+
+    // The annex directories of the notes.
+    vector<path> annexes() const
+    {
+        vector<path> r;
+        for(auto const & note: notes_)
+        {
+            if( !note.file.annex.empty() ) r.push_back(note.file.annex);
+        }
+        return r;
+    }
+
+    virtual bool directory(path dir)
+    {
+        orphans_.push_back(dir);
+        return true;
+    }
+
+    virtual bool file(File const & file)
+    {
+        auto it = previous_.find(file.filename);
+
+        if( !everything_stale_ && it != previous_.end() && 
+            !stale_.count(file.filename) &&
+            it->second.file.annex == file.annex )
+        {
+            notes_.push_back(std::move(it->second));
+            notes_.back().file = file; // annex stats from this listing
+        }
+        else
+        {
+            notes_.push_back(Note(file));
+        }
+
+        return true;
+    }
+
+private:
+    vector<Note> notes_;
+    vector<path> orphans_;
+
+    map<path, Note> previous_;
+    set<path> stale_;
+    bool everything_stale_ = false;
+};
+
+
+///////////////////////////////////////////////////////////////////////
+
+// The server and its clients give up on each other after these.
+int const SERVER_REQUEST_TIMEOUT_MS = 2000;
+int const SERVER_ANSWER_TIMEOUT_MS = 30000;
+
+// Read and write timeouts of a socket: calls then fail with EAGAIN.
+void set_socket_timeouts(int fd, int ms)
+{
+    timeval tv{ ms / 1000, (ms % 1000) * 1000 };
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+    setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
+}
+
+volatile std::sig_atomic_t server_stop = 0;
+
+extern "C" void server_signal(int)
+{
+    server_stop = 1;
+}
+
+/*
+Keeps the notes of a directory in memory and answers requests
+on a Unix domain socket.
+
+A request is one line: "check", "tags", "search TERM..." or 
+"find TERM...".
+The answer is the text the command would have printed.  The 
+server closes the connection after the answer.
+*/
+class NotesServer
+{
+public:
+    explicit NotesServer(path const & root) : root_(root) {}
+
+    ~NotesServer()
+    {
+        if( watch_fd_  != -1 ) close(watch_fd_);
+
+        if( listen_fd_ != -1 )
+        {
+            close(listen_fd_);
+            unlink(socket_path().c_str());
+        }
+    }
+
+    int run()
+    {
+        if( !listen() ) return 1;
+
+        watch();
+
+        vault_.load(root_);
+        watch_annexes();
+
+        std::signal(SIGINT,  server_signal);
+        std::signal(SIGTERM, server_signal);
+        std::signal(SIGPIPE, SIG_IGN);
+
+        wcout << "serving " << root_.wstring() << '\n' << std::flush;
+
+        while( !server_stop )
+        {
+            pollfd fds[2] = {
+                { listen_fd_, POLLIN, 0 },
+                { watch_fd_,  POLLIN, 0 }
+            };
+
+            int n = poll(fds, watch_fd_ == -1 ? 1 : 2, -1);
+
+            if( n < 0 )
+            {
+                if( errno == EINTR ) continue;
+                throw std::system_error(errno, std::system_category(), "poll");
+            }
+
+            if( fds[1].revents & POLLIN ) read_notifications();
+            if( fds[0].revents & POLLIN ) serve_one();
+        }
+
+        return 0;
+    }
+
+private:
+    std::string socket_path() const
+    {
+        return (root_ / SERVER_SOCKET_NAME).string();
+    }
+
+    bool listen()
+    {
+        sockaddr_un addr{};
+        addr.sun_family = AF_UNIX;
+
+        std::string sp = socket_path();
+        if( sp.size() >= sizeof(addr.sun_path) )
+        {
+            wcerr << "socket path too long\n";
+            return false;
+        }
+        sp.copy(addr.sun_path, sp.size());
+
+        int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if( fd == -1 )
+        {
+            throw std::system_error(errno, std::system_category(), "socket");
+        }
+
+        // A leftover socket from a server that did not exit cleanly
+        // is replaced, a live one is not.
+        if( connect(fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) == 0 )
+        {
+            close(fd);
+            wcerr << "a server is already running\n";
+            return false;
+        }
+        unlink(sp.c_str());
+
+        if( bind(fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) != 0 ||
+            ::listen(fd, 16) != 0 )
+        {
+            int err = errno;
+            close(fd);
+            throw std::system_error(err, std::system_category(), sp);
+        }
+
+        listen_fd_ = fd;
+        return true;
+    }
+
+    void watch()
+    {
+#ifdef __linux__
+        watch_fd_ = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if( watch_fd_ == -1 ) return;
+
+        root_watch_ = inotify_add_watch(watch_fd_, root_.string().c_str(), WATCH_MASK);
+        if( root_watch_ == -1 )
+        {
+            close(watch_fd_);
+            watch_fd_ = -1;
+        }
+#endif
+    }
+
+    /*
+    The checks of a note depend on its annex: the annex directories,
+    and the directories in them, are watched too.  Any change there 
+    loads the vault again, which lists the annexes again.  Called 
+    after each load: watching a directory twice is harmless, and the
+    watch of a removed directory goes away with it.
+    */
+    void watch_annexes()
+    {
+#ifdef __linux__
+        if( watch_fd_ == -1 ) return;
+
+        auto add = [&](path const & dir)
+        {
+            inotify_add_watch(watch_fd_, dir.string().c_str(), WATCH_MASK | IN_ONLYDIR);
+        };
+
+        for(auto const & annex: vault_.annexes())
+        {
+            add(annex);
+
+            boost::system::error_code ec;
+            boost::filesystem::recursive_directory_iterator it(annex, ec), end;
+            for(; !ec && it != end; it.increment(ec))
+            {
+                if( is_directory(it->symlink_status()) ) add(it->path());
+            }
+        }
+#endif
+    }
+
+    void read_notifications()
+    {
+#ifdef __linux__
+        alignas(inotify_event) char buf[4096];
+
+        for(;;)
+        {
+            ssize_t len = read(watch_fd_, buf, sizeof(buf));
+            if( len <= 0 ) break;
+
+            for(char * p = buf; p < buf + len; )
+            {
+                auto event = reinterpret_cast<inotify_event *>(p);
+
+                if( event->mask & IN_Q_OVERFLOW )
+                {
+                    vault_.invalidate();
+                }
+                else if( event->wd == root_watch_ && event->len )
+                {
+                    vault_.invalidate(root_ / event->name);
+                }
+                // else in an annex: the notes stay, the listing changes.
+
+                p += sizeof(inotify_event) + event->len;
+            }
+
+            dirty_ = true;
+        }
+#endif
+    }
+
+    void serve_one()
+    {
+        int fd = accept(listen_fd_, nullptr, nullptr);
+        if( fd == -1 ) return;
+
+        // A client that does not send its line in time, or does not
+        // read the answer, is dropped: it would block the others.
+        set_socket_timeouts(fd, SERVER_REQUEST_TIMEOUT_MS);
+
+        std::string request;
+        if( !read_request(fd, request) )
+        {
+            close(fd);
+            return;
+        }
+
+        std::string response = narrow( answer( widen(request) ) );
+
+        char const * p = response.data();
+        std::size_t left = response.size();
+        while( left )
+        {
+            ssize_t n = write(fd, p, left);
+            if( n <= 0 ) break;
+            p += n;
+            left -= n;
+        }
+
+        close(fd);
+    }
+
+    // The first line, read before the deadline.
+    static bool read_request(int fd, std::string & request)
+    {
+        auto deadline = std::chrono::steady_clock::now() + 
+            std::chrono::milliseconds(SERVER_REQUEST_TIMEOUT_MS);
+
+        char buf[512];
+        while( request.size() < 4096 )
+        {
+            auto left = std::chrono::duration_cast<std::chrono::milliseconds>(
+                deadline - std::chrono::steady_clock::now()).count();
+
+            pollfd p{ fd, POLLIN, 0 };
+            if( left <= 0 || poll(&p, 1, left) <= 0 ) return false;
+
+            ssize_t n = read(fd, buf, sizeof(buf));
+            if( n <= 0 ) return false;
+
+            std::size_t eol = std::string_view(buf, n).find('\n');
+            request.append(buf, eol == std::string_view::npos ? n : eol);
+            if( eol != std::string_view::npos ) return true;
+        }
+
+        return true;
+    }
+
+    wstring answer(wstring const & request)
+    {
+        // Without notifications, nothing tells us what is still good.
+        if( watch_fd_ == -1 )
+        {
+            vault_.invalidate();
+            dirty_ = true;
+        }
+
+        if( dirty_ )
+        {
+            vault_.load(root_);
+            watch_annexes();
+            find_index_ = boost::none;
+            dirty_ = false;
+        }
+
+        std::wostringstream os;
+
+        vector<wstring> words;
+        boost::algorithm::split(words, request, boost::algorithm::is_space(),
+            boost::algorithm::token_compress_on);
+
+        if( words.front() == L"check" )
+        {
+            WarningVisitor::Grouping grouping;
+            bool summary;
+
+            if( parse_check_options( vector<wstring>(words.begin() + 1, words.end()),
+                grouping, summary ) )
+            {
+                WarningVisitor visitor(os, grouping, summary);
+                vault_.replay(visitor);
+                visitor.report();
+            }
+            else
+            {
+                os << "error: invalid check options\n";
+            }
+        }
+        else if( request == L"tags" )
+        {
+            PrintTagsVisitor visitor(os);
+            vault_.replay(visitor);
+            visitor.print_tags();
+        }
+        else if( boost::algorithm::starts_with(request, L"search ") )
+        {
+            SearchVisitor visitor(request.substr(7), os);
+            vault_.replay(visitor);
+        }
+        else if( boost::algorithm::starts_with(request, L"find ") )
+        {
+            if( !find_index_ )
+            {
+                FindVisitor visitor;
+                vault_.replay(visitor);
+                find_index_ = std::move(visitor.index);
+            }
+
+            for(auto const & fn: find_index_->find(request.substr(5)))
+            {
+                os << fn.wstring() << '\n';
+            }
+        }
+        else
+        {
+            os << "error: unknown request \"" << request << "\"\n";
+        }
+
+        return os.str();
+    }
+
+    path root_;
+    Vault vault_;
+    optional<FindIndex> find_index_; // built on the first "find"
+
+#ifdef __linux__
+    static uint32_t const WATCH_MASK = IN_CREATE | IN_DELETE | IN_MODIFY | 
+        IN_CLOSE_WRITE | IN_MOVED_FROM | IN_MOVED_TO | IN_ATTRIB;
+#endif
+
+    int listen_fd_ = -1;
+    int watch_fd_ = -1;
+    int root_watch_ = -1;
+    bool dirty_ = false;
+};
+
+/*
+Sends the request to the server of the current directory and 
+copies the answer on the standard output.
+
+Returns false if there is no server, or it does not answer in time:
+the caller then does the work itself.  Nothing is written until the
+whole answer is in.
+*/
+bool ask_server(wstring const & request)
+{
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+
+    std::string sp = (path(".") / SERVER_SOCKET_NAME).string();
+    if( sp.size() >= sizeof(addr.sun_path) ) return false;
+    sp.copy(addr.sun_path, sp.size());
+
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if( fd == -1 ) return false;
+
+    set_socket_timeouts(fd, SERVER_ANSWER_TIMEOUT_MS);
+
+    if( connect(fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) != 0 )
+    {
+        close(fd);
+        return false;
+    }
+
+    std::string line = narrow(request) + '\n';
+    if( write(fd, line.data(), line.size()) != static_cast<ssize_t>(line.size()) )
+    {
+        close(fd);
+        return false;
+    }
+
+    std::string answer;
+    char buf[4096];
+    ssize_t n;
+    while( (n = read(fd, buf, sizeof(buf))) > 0 )
+    {
+        answer.append(buf, n);
+    }
+
+    close(fd);
+
+    // A timeout: no answer.
+    if( n < 0 ) return false;
+
+    wcout << widen(answer) << std::flush;
+    return true;
+}
+
+
+///////////////////////////////////////////////////////////////////////
+
+/*
+Signature of a text for near duplicate detection.
+
+MinHash over the shingles of 3 consecutive words: the similarity 
+of two signatures (fraction of equal minimums) estimates the 
+Jaccard similarity of the shingle sets.
+*/
+class MinHash
+{
+public:
+    static int const SIZE = 64;
+
+    // Locality sensitive hashing: a band is a group of minimums
+    // hashed together.  Texts sharing a band are compared.
+    static int const BANDS = 16;
+    static int const ROWS  = SIZE / BANDS;
+
+    explicit MinHash(wstring const & text)
+    {
+        minimums_.fill( std::numeric_limits<uint64_t>::max() );
+
+        vector<std::string> words;
+        {
+            std::wistringstream is(text);
+            wstring word;
+            while( is >> word )
+            {
+                boost::algorithm::to_lower(word);
+                words.push_back( utf8_from_wide(word) );
+            }
+        }
+
+        // A text of less than 3 words is a single shingle.
+        std::size_t shingles = words.size() < 3 ? 
+            std::min<std::size_t>(words.size(), 1) : words.size() - 2;
+
+        for(std::size_t i = 0; i != shingles; ++i)
+        {
+            std::string shingle = words[i];
+            for(std::size_t j = i + 1; j < i + 3 && j < words.size(); ++j)
+            {
+                shingle += ' ' + words[j];
+            }
+
+            uint64_t h = xxhash64(shingle);
+
+            // Permutations derived from one hash, cheaper than 
+            // hashing each shingle SIZE times.
+            for(int k = 0; k != SIZE; ++k)
+            {
+                uint64_t x = (h ^ multipliers()[k]) * 0x9E3779B97F4A7C15ull;
+                x ^= x >> 29;
+                minimums_[k] = std::min(minimums_[k], x);
+            }
+        }
+    }
+
+    double similarity(MinHash const & other) const
+    {
+        int same = 0;
+        for(int k = 0; k != SIZE; ++k)
+        {
+            if( minimums_[k] == other.minimums_[k] ) ++same;
+        }
+        return double(same) / SIZE;
+    }
+
+    uint64_t band(int b) const
+    {
+        return xxhash64( reinterpret_cast<char const *>(&minimums_[b * ROWS]), 
+            ROWS * sizeof(uint64_t), b );
+    }
+
+private:
+    static std::array<uint64_t, SIZE> const & multipliers()
+    {
+        static std::array<uint64_t, SIZE> const m = []()
+        {
+            std::array<uint64_t, SIZE> r;
+            uint64_t x = 0x2545F4914F6CDD1Dull;
+            for(auto & v: r)
+            {
+                // xorshift64
+                x ^= x << 13;
+                x ^= x >> 7;
+                x ^= x << 17;
+                v = x;
+            }
+            return r;
+        }();
+        return m;
+    }
+
+    std::array<uint64_t, SIZE> minimums_;
+};
+
+
+class DupesVisitor : public BaseDirectoryVisitor
+{
+public:
+    explicit DupesVisitor(double threshold, std::wostream & out = wcout) 
+        : BaseDirectoryVisitor(out), threshold_(threshold) {}
+
+    virtual bool directory(path)
+    {
+        return true;
+    }
+
+    virtual bool file(File const & file)
+    {
+        // Only the hashes are kept, not the notes.
+        Note note(file);
+
+        wstring trimmed = boost::algorithm::trim_copy(note.body);
+        if( trimmed.empty() ) return true;
+
+        uint64_t h = xxhash64( utf8_from_wide(note.body) );
+
+        auto & same = by_hash_[h];
+        same.push_back(note.file.filename);
+
+        // Identical bodies are compared as one.
+        if( same.size() == 1 )
+        {
+            filenames_.push_back(note.file.filename);
+            signatures_.emplace_back(note.body);
+        }
+
+        return true;
+    }
+
+    void print()
+    {
+        // The same hash only proposes: the bodies, read again, are 
+        // compared.  A body that differs is compared for similarity
+        // on its own.
+        for(auto const & h: by_hash_)
+        {
+            if( h.second.size() < 2 ) continue;
+
+            vector< std::pair< wstring, vector<path> > > groups;
+            for(auto const & fn: h.second)
+            {
+                wstring body;
+                try
+                {
+                    body = Note( File(fn) ).body;
+                }
+                catch(IOStreamError const & error)
+                {
+                    std::cerr << error.what() << "\n";
+                    continue;
+                }
+
+                auto g = std::find_if(groups.begin(), groups.end(), 
+                    [&](std::pair< wstring, vector<path> > const & g) { return g.first == body; });
+
+                if( g != groups.end() ) g->second.push_back(fn);
+                else groups.emplace_back(body, vector<path>{fn});
+            }
+
+            for(std::size_t g = 0; g != groups.size(); ++g)
+            {
+                // file() signed the first note of the hash.
+                if( groups[g].second.front() != h.second.front() )
+                {
+                    filenames_.push_back(groups[g].second.front());
+                    signatures_.emplace_back(groups[g].first);
+                }
+
+                if( groups[g].second.size() < 2 ) continue;
+
+                out_ << "Identical:\n";
+                for(auto const & fn: groups[g].second) out_ << "  " << fn.wstring() << '\n';
+                out_ << '\n';
+            }
+        }
+
+        // Bucketing makes the work proportional to the number of
+        // notes, not pairs: a note is paired with at most MAX_BUCKET
+        // others of a band.  Beyond, the band is too common, often
+        // short notes, to tell much.
+        set< std::pair<std::size_t, std::size_t> > candidates;
+
+        for(int b = 0; b != MinHash::BANDS; ++b)
+        {
+            std::unordered_map< uint64_t, vector<std::size_t> > buckets;
+
+            for(std::size_t i = 0; i != signatures_.size(); ++i)
+            {
+                auto & bucket = buckets[ signatures_[i].band(b) ];
+                if( bucket.size() == MAX_BUCKET ) continue;
+
+                for(auto j: bucket) candidates.emplace(j, i);
+                bucket.push_back(i);
+            }
+        }
+
+        for(auto const & c: candidates)
+        {
+            double sim = signatures_[c.first].similarity(signatures_[c.second]);
+            if( sim < threshold_ ) continue;
+
+            out_ << "Similar (" << int(sim * 100 + 0.5) << "%):\n";
+            out_ << "  " << filenames_[c.first ].wstring() << '\n';
+            out_ << "  " << filenames_[c.second].wstring() << '\n';
+            out_ << '\n';
+        }
+    }
+
+private:
+    static std::size_t const MAX_BUCKET = 64;
+
+    double threshold_;
+
+    map< uint64_t, vector<path> > by_hash_;
+
+    vector<path> filenames_;
+    vector<MinHash> signatures_;
+};
+
+
+///////////////////////////////////////////////////////////////////////
+
+/*
+Snapshot of the parsed notes of a directory.
+
+The file is made of a SnapshotHeader followed by sections.  Each
+section is one column: an array with one element per note, per
+string, per tag or per header field.  Columns are 8 bytes aligned
+so the file can be used in place once mapped.
+
+Strings (file names, tags, header fields) are interned, UTF-8 
+encoded and referred to by their index.  A note's tags are
+TAGS[ TAG_BEGINS[i] .. TAG_BEGINS[i+1] ), and likewise for header
+fields.
+
+The header fields make a columnar index: field names and values are
+interned, so a query on a field compares ids, and counting the values
+of a field is counting ids.
+
+The checksum covers everything after the header.  The snapshot is
+fresh while the directory, .notesignore and every note keep their
+modification time and size.  A stale snapshot is updated by 
+SnapshotUpdater, which parses again only the notes that changed.
+*/
+uint32_t const SNAPSHOT_VERSION = 4;
+uint32_t const NO_STRING = 0xFFFFFFFF;
+
+enum SnapshotSection
+{
+    STRING_OFFSETS,     // uint32, string count + 1 
+    STRING_BYTES,       // char
+    NOTE_MTIMES,        // int64
+    NOTE_SIZES,         // uint64
+    NOTE_CONTEXTS,      // uint64, check_context()
+    NOTE_FILENAMES,     // uint32 (string), in the directory
+    NOTE_ANNEXES,       // uint32 (string or NO_STRING)
+    NOTE_SPHERES,       // uint32 (string or NO_STRING)
+    NOTE_PROJECTS,      // uint32 (string or NO_STRING)
+    NOTE_SUBJECTS,      // uint32 (string or NO_STRING)
+    NOTE_BODY_OFFSETS,  // uint32, in characters
+    NOTE_FAILED_CHECKS, // uint32, bit set by CheckId
+    NOTE_LINK_COUNTS,   // uint32
+    NOTE_TAG_BEGINS,    // uint32, note count + 1
+    NOTE_FIELD_BEGINS,  // uint32, note count + 1
+    TAGS,               // uint32 (string)
+    FIELD_NAMES,        // uint32 (string)
+    FIELD_VALUES,       // uint32 (string)
+    SECTION_COUNT
+};
+
+struct SnapshotHeader
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t check_count;
+    uint32_t note_count;
+    uint32_t string_count;
+    int64_t ignore_mtime;
+    uint64_t checksum;
+    uint64_t size;
+    uint64_t sections[SECTION_COUNT];
+};
+
+char const SNAPSHOT_MAGIC[8] = { 'N', 'O', 'T', 'E', 'S', 'N', 'A', 'P' };
+
+
+class SnapshotWriter : public BaseDirectoryVisitor
+{
+public:
+    virtual bool directory(path)
+    {
+        return true;
+    }
+
+    void write(path const & root)
+    {
+        save(root, data(root));
+    }
+
+    // The content of the snapshot file.  Once, after the visit.
+    std::string data(path const & root)
+    {
+        columns_[STRING_OFFSETS].push_back(bytes_.size());
+
+        close_column(NOTE_TAG_BEGINS,   TAGS);
+        close_column(NOTE_FIELD_BEGINS, FIELD_NAMES);
+
+        SnapshotHeader header{};
+        std::copy(SNAPSHOT_MAGIC, SNAPSHOT_MAGIC + 8, header.magic);
+        header.version = SNAPSHOT_VERSION;
+        header.check_count = CHECK_COUNT;
+        header.note_count = mtimes_.size();
+        header.string_count = ids_.size();
+        header.ignore_mtime = mtime_of(root / ".notesignore");
+
+        std::string data(sizeof(header), '\0');
+
+        for(int i = 0; i != SECTION_COUNT; ++i)
+        {
+            header.sections[i] = data.size();
+
+            switch( i )
+            {
+            case STRING_BYTES: append(data, bytes_.data(), bytes_.size()); break;
+            case NOTE_MTIMES:  append(data, mtimes_); break;
+            case NOTE_SIZES:   append(data, sizes_);  break;
+            case NOTE_CONTEXTS: append(data, contexts_); break;
+            default:           append(data, columns_[i]); break;
+            }
+
+            data.resize( (data.size() + 7) / 8 * 8, '\0' );
+        }
+
+        header.size = data.size();
+        header.checksum = fnv1a(data.data() + sizeof(header), 
+            data.size() - sizeof(header));
+
+        std::memcpy(&data[0], &header, sizeof(header));
+
+        return data;
+    }
+
+    static void save(path const & root, std::string const & data)
+    {
+        path file = root / SNAPSHOT_NAME;
+        path tmp = file;
+        tmp += ".tmp";
+
+        std::ofstream fs(tmp.string(), std::ios::binary);
+        fs.write(data.data(), data.size());
+        fs.close();
+
+        if( !fs )
+        {
+            throw std::system_error(errno, std::system_category(), tmp.string());
+        }
+
+        boost::filesystem::rename(tmp, file);
+    }
+
+protected:
+    virtual bool note(Note const & note)
+    {
+        uint64_t size;
+        mtimes_.push_back( mtime_of(note.file.filename, &size) );
+        sizes_.push_back(size);
+
+        columns_[NOTE_FILENAMES].push_back( intern(note.file.filename.filename().wstring()) );
+
+        columns_[NOTE_ANNEXES].push_back( note.file.annex.empty() ? 
+            NO_STRING : intern(note.file.annex.filename().wstring()) );
+
+        columns_[NOTE_SPHERES ].push_back( intern(note.name.sphere ) );
+        columns_[NOTE_PROJECTS].push_back( intern(note.name.project) );
+        columns_[NOTE_SUBJECTS].push_back( intern(note.name.subject) );
+
+        columns_[NOTE_BODY_OFFSETS ].push_back(note.body_offset);
+        columns_[NOTE_FAILED_CHECKS].push_back( failed_checks(note) );
+        columns_[NOTE_LINK_COUNTS  ].push_back(note.links.size());
+        contexts_.push_back( check_context(note.file, !note.links.empty()) );
+
+        columns_[NOTE_TAG_BEGINS].push_back( columns_[TAGS].size() );
+        for(auto const & tag: note.tags)
+        {
+            columns_[TAGS].push_back( intern(tag) );
+        }
+
+        columns_[NOTE_FIELD_BEGINS].push_back( columns_[FIELD_NAMES].size() );
+        for(auto const & field: note.header)
+        {
+            columns_[FIELD_NAMES ].push_back( intern(field.first ) );
+            columns_[FIELD_VALUES].push_back( intern(field.second) );
+        }
+
+        return true;
+    }
+
+    uint32_t intern(wstring const & s)
+    {
+        return intern_utf8( utf8_from_wide(s) );
+    }
+
+    uint32_t intern(optional<wstring> const & s)
+    {
+        return s ? intern(*s) : NO_STRING;
+    }
+
+    uint32_t intern_utf8(std::string const & s)
+    {
+        auto it = ids_.find(s);
+        if( it != ids_.end() ) return it->second;
+
+        uint32_t id = ids_.size();
+        ids_.emplace(s, id);
+
+        columns_[STRING_OFFSETS].push_back(bytes_.size());
+        bytes_ += s;
+
+        return id;
+    }
+
+    vector<int64_t> mtimes_;
+    vector<uint64_t> sizes_;
+    vector<uint64_t> contexts_;
+    vector<uint32_t> columns_[SECTION_COUNT];
+
+private:
+
+    void close_column(SnapshotSection begins, SnapshotSection column)
+    {
+        columns_[begins].push_back( columns_[column].size() );
+    }
+
+    template <typename T>
+    static void append(std::string & data, vector<T> const & v)
+    {
+        append(data, reinterpret_cast<char const *>(v.data()), v.size() * sizeof(T));
+    }
+
+    static void append(std::string & data, char const * p, std::size_t size)
+    {
+        data.append(p, size);
+    }
+
+    std::unordered_map<std::string, uint32_t> ids_;
+    std::string bytes_;
+};
+
+
+// A snapshot file, mapped in memory.
+class Snapshot
+{
+public:
+    Snapshot() {}
+    Snapshot(Snapshot const &) = delete;
+    Snapshot & operator =(Snapshot const &) = delete;
+
+    ~Snapshot()
+    {
+        release();
+    }
+
+    // False if there is no valid snapshot of this version.
+    bool open(path const & file)
+    {
+        release();
+
+        int fd = ::open(file.string().c_str(), O_RDONLY | O_CLOEXEC);
+        if( fd == -1 ) return false;
+
+        struct stat st;
+        if( fstat(fd, &st) != 0 || 
+            static_cast<std::size_t>(st.st_size) < sizeof(SnapshotHeader) )
+        {
+            close(fd);
+            return false;
+        }
+
+        void * p = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        close(fd);
+        if( p == MAP_FAILED ) return false;
+
+        data_ = static_cast<char const *>(p);
+        size_ = st.st_size;
+        mapped_ = true;
+
+        if( !valid() )
+        {
+            wcerr << "warning: ignoring invalid " << file.wstring() << '\n';
+            release();
+            return false;
+        }
+
+        return true;
+    }
+
+    // From the content of a snapshot file, kept in memory.
+    bool open_data(std::string data)
+    {
+        release();
+
+        if( data.size() < sizeof(SnapshotHeader) ) return false;
+
+        owned_ = std::move(data);
+        data_ = owned_.data();
+        size_ = owned_.size();
+
+        if( !valid() )
+        {
+            release();
+            return false;
+        }
+
+        return true;
+    }
+
+    /*
+    Fresh if SnapshotUpdater would copy every row: the same notes, with
+    the same size, modification time and context of their checks, which
+    covers their annex and, for the notes with links, all the annexes.
+    Not the modification time of the directory: it changes with every
+    file written there, this snapshot included.
+    */
+    bool fresh(path const & root) const
+    {
+        if( header().ignore_mtime != mtime_of(root / ".notesignore") ) return false;
+
+        std::unordered_map<std::string_view, uint32_t> rows;
+        for(uint32_t i = 0; i != note_count(); ++i) rows.emplace(utf8(column(NOTE_FILENAMES)[i]), i);
+
+        struct Visitor : public DirectoryVisitor
+        {
+            Visitor(Snapshot const & snapshot, std::unordered_map<std::string_view, uint32_t> const & rows) 
+                : snapshot(snapshot), rows(rows) {}
+
+            virtual bool directory(path) { return true; }
+
+            virtual bool file(File const & file)
+            {
+                auto row = rows.find( utf8_from_wide(file.filename.filename().wstring()) );
+                if( row == rows.end() ) return fresh = false;
+
+                uint32_t i = row->second;
+                uint64_t size;
+                int64_t mtime = mtime_of(file.filename, &size);
+                bool links = snapshot.column(NOTE_LINK_COUNTS)[i] != 0;
+
+                fresh = mtime == snapshot.column<int64_t>(NOTE_MTIMES)[i] &&
+                    size == snapshot.column<uint64_t>(NOTE_SIZES)[i] &&
+                    check_context(file, links) == snapshot.column<uint64_t>(NOTE_CONTEXTS)[i];
+
+                ++files;
+                return fresh;
+            }
+
+            Snapshot const & snapshot;
+            std::unordered_map<std::string_view, uint32_t> const & rows;
+            bool fresh = true;
+            uint32_t files = 0;
+        };
+
+        Visitor visitor(*this, rows);
+        visit(root, visitor, load_ignore(root));
+
+        // A note removed is missed by the visit, not by the count.
+        return visitor.fresh && visitor.files == note_count();
+    }
+
+    SnapshotHeader const & header() const
+    {
+        return *reinterpret_cast<SnapshotHeader const *>(data_);
+    }
+
+    uint32_t note_count() const
+    {
+        return header().note_count;
+    }
+
+    uint32_t string_count() const
+    {
+        return header().string_count;
+    }
+
+    template <typename T = uint32_t>
+    T const * column(SnapshotSection section) const
+    {
+        return reinterpret_cast<T const *>(data_ + header().sections[section]);
+    }
+
+    wstring string(uint32_t id) const
+    {
+        std::string_view s = utf8(id);
+        return wide_from_utf8(s.data(), s.size());
+    }
+
+    std::string_view utf8(uint32_t id) const
+    {
+        uint32_t const * offsets = column(STRING_OFFSETS);
+        char const * bytes = column<char>(STRING_BYTES);
+
+        return std::string_view(bytes + offsets[id], offsets[id + 1] - offsets[id]);
+    }
+
+    // The id of a string, or NO_STRING: compares bytes, decodes nothing.
+    uint32_t find(wstring const & s) const
+    {
+        std::string bytes = utf8_from_wide(s);
+        for(uint32_t id = 0; id != string_count(); ++id)
+        {
+            if( utf8(id) == bytes ) return id;
+        }
+        return NO_STRING;
+    }
+
+    // The string of a note's string column.
+    wstring string(SnapshotSection section, uint32_t note) const
+    {
+        return string( column(section)[note] );
+    }
+
+private:
+    bool valid() const
+    {
+        SnapshotHeader const & h = header();
+
+        if( !std::equal(SNAPSHOT_MAGIC, SNAPSHOT_MAGIC + 8, h.magic) ) return false;
+        if( h.version != SNAPSHOT_VERSION ) return false;
+        if( h.check_count != CHECK_COUNT ) return false;
+        if( h.size != size_ ) return false;
+
+        for(auto offset: h.sections)
+        {
+            if( offset > size_ || offset % 8 ) return false;
+        }
+
+        return h.checksum == fnv1a(data_ + sizeof(h), size_ - sizeof(h));
+    }
+
+    void release()
+    {
+        if( mapped_ ) munmap(const_cast<char *>(data_), size_);
+        owned_ = std::string();
+        data_ = nullptr;
+        size_ = 0;
+        mapped_ = false;
+    }
+
+    char const * data_ = nullptr;
+    std::size_t size_ = 0;
+    bool mapped_ = false;   // else in owned_
+    std::string owned_;
+};
+
+
+/*
+Writes the snapshot of a directory again, copying the rows of the 
+previous snapshot for the notes that did not change: same name, 
+modification time, size and check context.  Only the other notes are 
+read and parsed.  A new .notesignore, or no valid previous snapshot,
+means parsing every note.
+*/
+class SnapshotUpdater : public SnapshotWriter
+{
+public:
+    explicit SnapshotUpdater(path const & root)
+    {
+        if( !old_.open(root / SNAPSHOT_NAME) ) return;
+        if( old_.header().ignore_mtime != mtime_of(root / ".notesignore") ) return;
+
+        for(uint32_t i = 0; i != old_.note_count(); ++i)
+        {
+            rows_.emplace(old_.utf8( old_.column(NOTE_FILENAMES)[i] ), i);
+        }
+    }
+
+    virtual bool file(File const & file)
+    {
+        auto row = rows_.find( utf8_from_wide(file.filename.filename().wstring()) );
+        if( row != rows_.end() && unchanged(file, row->second) )
+        {
+            copy(row->second);
+            return true;
+        }
+
+        ++ parsed_;
+        return SnapshotWriter::file(file);
+    }
+
+    // The notes read, not copied.
+    std::size_t parsed() const
+    {
+        return parsed_;
+    }
+
+private:
+    bool unchanged(File const & file, uint32_t i) const
+    {
+        uint64_t size;
+        int64_t mtime = mtime_of(file.filename, &size);
+
+        bool links = old_.column(NOTE_LINK_COUNTS)[i] != 0;
+
+        return mtime == old_.column<int64_t>(NOTE_MTIMES)[i] &&
+            size == old_.column<uint64_t>(NOTE_SIZES)[i] &&
+            check_context(file, links) == old_.column<uint64_t>(NOTE_CONTEXTS)[i];
+    }
+
+    void copy(uint32_t i)
+    {
+        mtimes_  .push_back( old_.column<int64_t> (NOTE_MTIMES  )[i] );
+        sizes_   .push_back( old_.column<uint64_t>(NOTE_SIZES   )[i] );
+        contexts_.push_back( old_.column<uint64_t>(NOTE_CONTEXTS)[i] );
+
+        for(auto section: {NOTE_FILENAMES, NOTE_ANNEXES, NOTE_SPHERES, 
+            NOTE_PROJECTS, NOTE_SUBJECTS})
+        {
+            columns_[section].push_back( string(old_.column(section)[i]) );
+        }
+
+        for(auto section: {NOTE_BODY_OFFSETS, NOTE_FAILED_CHECKS, NOTE_LINK_COUNTS})
+        {
+            columns_[section].push_back( old_.column(section)[i] );
+        }
+
+        copy_range(i, NOTE_TAG_BEGINS, {TAGS});
+        copy_range(i, NOTE_FIELD_BEGINS, {FIELD_NAMES, FIELD_VALUES});
+    }
+
+    void copy_range(uint32_t i, SnapshotSection begins, 
+        std::initializer_list<SnapshotSection> sections)
+    {
+        columns_[begins].push_back( columns_[*sections.begin()].size() );
+
+        uint32_t const * old_begins = old_.column(begins);
+        for(auto section: sections)
+        {
+            uint32_t const * ids = old_.column(section);
+            for(uint32_t j = old_begins[i]; j != old_begins[i + 1]; ++j)
+            {
+                columns_[section].push_back( string(ids[j]) );
+            }
+        }
+    }
+
+    // The id in the new snapshot of a string of the old one.
+    uint32_t string(uint32_t old_id)
+    {
+        if( old_id == NO_STRING ) return NO_STRING;
+        return intern_utf8( std::string(old_.utf8(old_id)) );
+    }
+
+    Snapshot old_;
+    std::unordered_map<std::string_view, uint32_t> rows_;
+    std::size_t parsed_ = 0;
+};
+
+/*
+Opens the snapshot of a directory, first updating it if it is missing
+or stale.  The update is saved unless told not to; if it cannot be, 
+on a read-only vault for instance, it is used from memory.
+*/
+void open_snapshot(path const & root, Snapshot & snapshot, bool save = true)
+{
+    if( snapshot.open(root / SNAPSHOT_NAME) && snapshot.fresh(root) ) return;
+
+    std::string data;
+    {
+        SnapshotUpdater updater(root);
+        visit(root, updater);
+        data = updater.data(root);
+    }
+
+    if( save )
+    {
+        try
+        {
+            SnapshotWriter::save(root, data);
+        }
+        catch(std::exception const &)
+        {
+            // Not saved: it is still good for this run.
+        }
+    }
+
+    if( !snapshot.open_data(std::move(data)) )
+    {
+        throw std::logic_error("invalid snapshot written");
+    }
+}
+
+
+// The tags report, computed from a fresh snapshot.
+bool print_tags_from_snapshot(path const & root)
+{
+    Snapshot snapshot;
+    if( !snapshot.open(root / SNAPSHOT_NAME) || !snapshot.fresh(root) ) 
+        return false;
+
+    // Same accounting as BaseDirectoryVisitor, on string ids.
+    vector<int> sphere_counts (snapshot.string_count());
+    vector<int> project_counts(snapshot.string_count());
+    vector<int> tag_counts    (snapshot.string_count());
+
+    uint32_t const * spheres  = snapshot.column(NOTE_SPHERES);
+    uint32_t const * projects = snapshot.column(NOTE_PROJECTS);
+    uint32_t const * begins   = snapshot.column(NOTE_TAG_BEGINS);
+    uint32_t const * tags     = snapshot.column(TAGS);
+
+    for(uint32_t i = 0; i != snapshot.note_count(); ++i)
+    {
+        if( spheres [i] != NO_STRING ) ++  sphere_counts[ spheres[i]];
+        if( projects[i] != NO_STRING ) ++ project_counts[projects[i]];
+
+        for(uint32_t t = begins[i]; t != begins[i + 1]; ++t) ++ tag_counts[tags[t]];
+    }
+
+    auto table = [&](vector<int> const & counts)
+    {
+        map<wstring, int> r;
+        for(uint32_t id = 0; id != counts.size(); ++id)
+        {
+            if( counts[id] ) r[snapshot.string(id)] = counts[id];
+        }
+        return r;
+    };
+
+    print_tags_report(wcout, table(sphere_counts), table(project_counts), 
+        table(tag_counts));
+
+    return true;
+}
+
+// The find index, from a fresh snapshot.
+bool find_index_from_snapshot(path const & root, FindIndex & index)
+{
+    Snapshot snapshot;
+    if( !snapshot.open(root / SNAPSHOT_NAME) || !snapshot.fresh(root) ) 
+        return false;
+
+    uint32_t const * begins = snapshot.column(NOTE_FIELD_BEGINS);
+    uint32_t const * names  = snapshot.column(FIELD_NAMES);
+    uint32_t const * values = snapshot.column(FIELD_VALUES);
+
+    auto string = [&](SnapshotSection section, uint32_t i)
+    {
+        uint32_t id = snapshot.column(section)[i];
+        return id == NO_STRING ? optional<wstring>() : snapshot.string(id);
+    };
+
+    for(uint32_t i = 0; i != snapshot.note_count(); ++i)
+    {
+        optional<wstring> subject_field;
+        for(uint32_t f = begins[i]; f != begins[i + 1]; ++f)
+        {
+            if( snapshot.string(names[f]) == SUBJECT_FIELD_NAME ) 
+                subject_field = snapshot.string(values[f]);
+        }
+
+        index.add( root / snapshot.string(NOTE_FILENAMES, i), 
+            string(NOTE_SPHERES, i), string(NOTE_PROJECTS, i), 
+            string(NOTE_SUBJECTS, i), subject_field );
+    }
+
+    return true;
+}
+
+class LackingFieldVisitor : public BaseDirectoryVisitor
+{
+public:
+    explicit LackingFieldVisitor(wstring const & field) : field_(field) {}
+
+    virtual bool directory(path)
+    {
+        return true;
+    }
+
+protected:
+    virtual bool note(Note const & note)
+    {
+        if( !note.header.count(field_) )
+        {
+            out_ << note.file.filename.wstring() << '\n';
+        }
+        return true;
+    }
+
+private:
+    wstring field_;
+};
+
+// The notes without a header field, from a fresh snapshot.
+bool print_lacking_from_snapshot(path const & root, wstring const & field)
+{
+    Snapshot snapshot;
+    if( !snapshot.open(root / SNAPSHOT_NAME) || !snapshot.fresh(root) ) 
+        return false;
+
+    uint32_t const * begins = snapshot.column(NOTE_FIELD_BEGINS);
+    uint32_t const * names  = snapshot.column(FIELD_NAMES);
+
+    // Compare ids, not strings.
+    uint32_t field_id = snapshot.find(field);
+
+    for(uint32_t i = 0; i != snapshot.note_count(); ++i)
+    {
+        if( std::find(names + begins[i], names + begins[i + 1], field_id) == 
+            names + begins[i + 1] )
+        {
+            wcout << (root / snapshot.string(NOTE_FILENAMES, i)).wstring() << '\n';
+        }
+    }
+
+    return true;
+}
+
+/*
+The notes with every one of the header fields given, each with the 
+value given.
+*/
+void print_where_from_snapshot(std::wostream & out, path const & root, 
+    Snapshot const & snapshot, vector< std::pair<wstring, wstring> > const & conditions)
+{
+    uint32_t const * begins = snapshot.column(NOTE_FIELD_BEGINS);
+    uint32_t const * names  = snapshot.column(FIELD_NAMES);
+    uint32_t const * values = snapshot.column(FIELD_VALUES);
+
+    vector< std::pair<uint32_t, uint32_t> > ids;
+    for(auto const & c: conditions)
+    {
+        ids.emplace_back( snapshot.find(c.first), snapshot.find(c.second) );
+
+        // A name or value no note has: nothing matches.
+        if( ids.back().first == NO_STRING || ids.back().second == NO_STRING ) return;
+    }
+
+    for(uint32_t i = 0; i != snapshot.note_count(); ++i)
+    {
+        auto matches = [&](std::pair<uint32_t, uint32_t> const & c)
+        {
+            for(uint32_t f = begins[i]; f != begins[i + 1]; ++f)
+            {
+                if( names[f] == c.first && values[f] == c.second ) return true;
+            }
+            return false;
+        };
+
+        if( std::all_of(ids.begin(), ids.end(), matches) )
+        {
+            out << (root / snapshot.string(NOTE_FILENAMES, i)).wstring() << '\n';
+        }
+    }
+}
+
+/*
+The header fields of the notes: for each, the number of notes that 
+have it and of distinct values.  With a field name, the values of that
+field and their number of notes instead.
+*/
+void print_fields_from_snapshot(std::wostream & out, Snapshot const & snapshot, 
+    optional<wstring> const & field)
+{
+    uint32_t const * names  = snapshot.column(FIELD_NAMES);
+    uint32_t const * values = snapshot.column(FIELD_VALUES);
+    uint32_t field_count = snapshot.column(NOTE_FIELD_BEGINS)[snapshot.note_count()];
+
+    if( field )
+    {
+        uint32_t field_id = snapshot.find(*field);
+
+        vector<int> counts(snapshot.string_count());
+        for(uint32_t f = 0; f != field_count; ++f)
+        {
+            if( names[f] == field_id ) ++ counts[values[f]];
+        }
+
+        map<wstring, int> table;
+        for(uint32_t id = 0; id != counts.size(); ++id)
+        {
+            if( counts[id] ) table[snapshot.string(id)] = counts[id];
+        }
+
+        print_tag_table(out, *field, table);
+        return;
+    }
+
+    // Pairs of ids, name in the high bits: sorted, they group by name.
+    vector<uint64_t> pairs(field_count);
+    for(uint32_t f = 0; f != field_count; ++f)
+    {
+        pairs[f] = uint64_t(names[f]) << 32 | values[f];
+    }
+    std::sort(pairs.begin(), pairs.end());
+
+    map< wstring, std::pair<int, int> > table;  // notes, values
+    for(std::size_t f = 0; f != pairs.size(); ++f)
+    {
+        auto & counts = table[ snapshot.string(pairs[f] >> 32) ];
+        ++ counts.first;
+        if( f == 0 || pairs[f] != pairs[f - 1] ) ++ counts.second;
+    }
+
+    out << "Fields:\n";
+    for(auto const & t: table)
+    {
+        out << "  ";
+        out << std::setw(20) << std::left << t.first;
+        out << std::setw(6) << std::right << t.second.first << " notes";
+        out << std::setw(6) << std::right << t.second.second << " values";
+        out << '\n';
+    }
+}
+
+
+///////////////////////////////////////////////////////////////////////
+
+/*
+Runs git on the repository of the directory and returns what it 
+writes, or none if it cannot run or fails.  Nothing goes through a 
+shell, and git only reads the local repository.
+*/
+optional<std::string> run_git(path const & dir, vector<std::string> const & args)
+{
+    // Built before the fork: the child only calls what is safe there.
+    vector<std::string> all{ "git", "-C", dir.string() };
+    all.insert(all.end(), args.begin(), args.end());
+
+    vector<char *> argv;
+    for(auto & a: all) argv.push_back(&a[0]);
+    argv.push_back(nullptr);
+
+    int fds[2];
+    if( pipe(fds) != 0 ) return boost::none;
+
+    pid_t pid = fork();
+    if( pid < 0 )
+    {
+        close(fds[0]);
+        close(fds[1]);
+        return boost::none;
+    }
+
+    if( pid == 0 )
+    {
+        dup2(fds[1], STDOUT_FILENO);
+        close(fds[0]);
+        close(fds[1]);
+
+        execvp("git", argv.data());
+        _exit(127);
+    }
+
+    close(fds[1]);
+
+    std::string out;
+    char buffer[65536];
+
+    for(;;)
+    {
+        ssize_t n = read(fds[0], buffer, sizeof(buffer));
+        if( n < 0 && errno == EINTR ) continue;
+        if( n <= 0 ) break;
+        out.append(buffer, n);
+    }
+
+    close(fds[0]);
+
+    int status = 0;
+    while( waitpid(pid, &status, 0) < 0 && errno == EINTR ) {}
+
+    if( !WIFEXITED(status) || WEXITSTATUS(status) != 0 ) return boost::none;
+    return out;
+}
+
+/*
+The stems of the notes of the directory that changed since a revision
+(in the working tree, the new notes git does not track yet included) 
+or that are staged.  A change in an annex is a change of its note.  
+None if git fails, it says why.
+*/
+optional< set<wstring> > changed_stems(path const & dir, ScanOptions const & scan)
+{
+    vector<std::string> args{ "diff", "--name-only", "-z", "--relative" };
+    if( scan.staged ) args.push_back("--cached");
+    if( scan.since ) args.push_back(*scan.since);
+    args.push_back("--");
+
+    auto out = run_git(dir, args);
+    if( !out ) return boost::none;
+
+    if( !scan.staged )
+    {
+        auto untracked = run_git(dir, { "ls-files", "--others", "--exclude-standard", "-z" });
+        if( !untracked ) return boost::none;
+        *out += *untracked;
+    }
+
+    set<wstring> stems;
+
+    std::size_t begin = 0;
+    for(std::size_t end; (end = out->find('\0', begin)) != std::string::npos; begin = end + 1)
+    {
+        std::string name = out->substr(begin, end - begin);
+        name = name.substr(0, name.find('/'));
+
+        stems.insert( path(name).stem().wstring() );
+    }
+
+    return stems;
+}
+
+
+///////////////////////////////////////////////////////////////////////
+
+int normal_main(int argc, char ** argv)
+{
+    vector<wstring> args;
+    for(int i = 2; i < argc; ++i) args.push_back( widen(argv[i]) );
+
+    WarningVisitor::Grouping grouping;
+    bool summary;
+    vector<path> roots;
+    ScanOptions scan;
+
+    if( !parse_check_options(args, grouping, summary, &roots, &scan) ||
+        scan.sharded() == scan.output.empty() )
+    {
+        wcerr << "invalid check option, try \"--help\"\n";
+        return 1;
+    }
+
+    if( roots.empty() )
+    {
+        // The server has the notes in memory already, and knows 
+        // nothing of the scan options.
+        wstring request(L"check");
+        for(auto const & arg: args) request += L' ' + arg;
+
+        bool scan_options = scan.max_memory != 0 || scan.stats || scan.incremental() ||
+            scan.sharded();
+        if( !scan_options && ask_server(request) ) return 0;
+
+        roots.push_back(".");
+    }
+
+    // Shards may run side by side on the same notes: they would race
+    // on the store.  Archives have none.
+    bool use_store = !scan.incremental() && !scan.sharded();
+
+    // All the roots are checked by the same threads, and then 
+    // reported one after the other.
+    vector< std::unique_ptr<WarningVisitor> > visitors;
+    vector<WarningVisitor *> all;
+    vector<CleanStore> stores(roots.size());
+
+    for(std::size_t i = 0; i != roots.size(); ++i)
+    {
+        visitors.emplace_back( new WarningVisitor(wcout, grouping, summary, 
+            scan.batch_size()) );
+        all.push_back( visitors.back().get() );
+
+        // Only the changed notes: git knows them, not the store.
+        optional< set<wstring> > changed;
+        if( scan.incremental() )
+        {
+            changed = changed_stems(roots[i], scan);
+            if( !changed )
+            {
+                wcerr << "cannot list the changes of " << roots[i].wstring() << " in git\n";
+                return 1;
+            }
+        }
+        else if( use_store && is_directory(roots[i]) )
+        {
+            stores[i].load(roots[i]);
+            visitors.back()->remember(stores[i]);
+        }
+
+        ShardVisitor shard(*visitors.back(), scan);
+        auto source = open_source(roots[i]);
+        visit(source, shard, load_ignore(*source), changed.get_ptr());
+    }
+
+    WarningVisitor::check_pending(all);
+
+    if( scan.sharded() )
+    {
+        ResultsWriter results;
+        results.put( uint32_t(roots.size()) );
+
+        for(std::size_t i = 0; i != roots.size(); ++i)
+        {
+            results.put(roots[i].wstring());
+            visitors[i]->save(results);
+        }
+
+        results.save(scan.output, CHECK_RESULTS, scan.shard, scan.shards);
+    }
+
+    for(std::size_t i = 0; i != roots.size() && !scan.sharded(); ++i)
+    {
+        if( roots.size() > 1 ) wcout << (i ? "\n" : "") << roots[i].wstring() << ":\n";
+        visitors[i]->report();
+        if( use_store && is_directory(roots[i]) ) save_clean_store(stores[i], roots[i]);
+    }
+
+    if( scan.stats )
+    {
+        std::size_t checked = 0;
+        std::size_t unchanged = 0;
+        for(auto v: all) 
+        {
+            checked += v->checked();
+            unchanged += v->unchanged();
+        }
+        print_stats(wcout, checked, unchanged);
+    }
+
+    return 0;
+}
+
+// The tags of each root and of all of them, or of the only one.
+void print_tags_of_roots(vector<path> const & roots, 
+    vector<PrintTagsVisitor> & visitors, PrintTagsVisitor & combined)
+{
+    if( roots.size() == 1 )
+    {
+        combined.print_tags();
+        return;
+    }
+
+    for(std::size_t i = 0; i != roots.size(); ++i)
+    {
+        wcout << roots[i].wstring() << ":\n\n";
+        visitors[i].print_tags();
+        wcout << '\n';
+    }
+
+    wcout << "All roots:\n\n";
+    combined.print_tags();
+}
+
+int print_tags_main(int argc, char ** argv)
+{
+    vector<wstring> args;
+    for(int i = 2; i < argc; ++i) args.push_back( widen(argv[i]) );
+
+    vector<path> roots;
+    ScanOptions scan;
+
+    for(std::size_t i = 0; i != args.size(); ++i)
+    {
+        if( !boost::algorithm::starts_with(args[i], L"--") )
+        {
+            roots.push_back(args[i]);
+        }
+        else if( !parse_scan_option(args, i, scan) )
+        {
+            wcerr << "invalid tags option, try \"--help\"\n";
+            return 1;
+        }
+    }
+
+    if( scan.sharded() == scan.output.empty() )
+    {
+        wcerr << "invalid tags option, try \"--help\"\n";
+        return 1;
+    }
+
+    bool scan_options = scan.max_memory != 0 || scan.stats || scan.sharded();
+
+    if( roots.empty() )
+    {
+        if( !scan_options && ask_server(L"tags") ) return 0;
+
+        if( !scan_options && print_tags_from_snapshot(".") ) return 0;
+
+        roots.push_back(".");
+    }
+
+    // The notes of all the roots are loaded by the same threads.
+    PrintTagsVisitor combined;
+    vector<PrintTagsVisitor> visitors(roots.size());
+    std::size_t loaded = 0;
+
+    for(std::size_t i = 0; i != roots.size(); ++i)
+    {
+        auto load = [&](vector<File> & files)
+        {
+            load_parallel(files, [&](Note const & note)
+            {
+                visitors[i].loaded(note);
+                combined.loaded(note);
+            });
+
+            loaded += files.size();
+        };
+
+        FileListVisitor list(scan.batch_size(), load);
+        ShardVisitor shard(list, scan);
+        auto source = open_source(roots[i]);
+        visit(source, shard, load_ignore(*source));
+        load(list.files);
+    }
+
+    if( scan.sharded() )
+    {
+        ResultsWriter results;
+        results.put( uint32_t(roots.size()) );
+
+        for(std::size_t i = 0; i != roots.size(); ++i)
+        {
+            results.put(roots[i].wstring());
+            visitors[i].save_tags(results);
+        }
+
+        results.save(scan.output, TAGS_RESULTS, scan.shard, scan.shards);
+    }
+    else
+    {
+        print_tags_of_roots(roots, visitors, combined);
+    }
+
+    if( scan.stats ) print_stats(wcout, loaded);
+
+    return 0;
+}
+
+/*
+"merge [--group-by file|check|tag] [--summary] FILE...": reports the
+results saved by all the shards of a "check --shard" or of a "tags 
+--shard", as the command does without shards.
+*/
+int merge_main(int argc, char ** argv)
+{
+    vector<wstring> args;
+    for(int i = 2; i < argc; ++i) args.push_back( widen(argv[i]) );
+
+    WarningVisitor::Grouping grouping;
+    bool summary;
+    vector<path> files;
+
+    if( !parse_check_options(args, grouping, summary, &files) || files.empty() )
+    {
+        wcerr << "invalid merge option, try \"--help\"\n";
+        return 1;
+    }
+
+    vector< std::unique_ptr<ResultsReader> > shards;
+    for(auto const & file: files) shards.emplace_back( new ResultsReader(file) );
+
+    ResultsHeader const & first = shards.front()->header();
+    vector<char> seen(first.shards + 1);
+
+    for(auto const & shard: shards)
+    {
+        ResultsHeader const & h = shard->header();
+        if( h.kind != first.kind || h.shards != first.shards || seen[h.shard]++ )
+        {
+            wcerr << "the results are not of the shards of one run\n";
+            return 1;
+        }
+    }
+
+    if( shards.size() != first.shards )
+    {
+        wcerr << "missing results: " << first.shards - shards.size() << " of ";
+        wcerr << first.shards << " shards\n";
+        return 1;
+    }
+
+    uint32_t root_count = shards.front()->get();
+    bool same_run = true;
+
+    for(std::size_t i = 1; i != shards.size(); ++i)
+    {
+        if( shards[i]->get() != root_count ) same_run = false;
+    }
+
+    // The roots are in the same order in all the shards, each with 
+    // its results.
+    vector<path> roots;
+    vector< std::unique_ptr<WarningVisitor> > warnings;
+    vector<PrintTagsVisitor> tags(root_count);
+
+    for(uint32_t i = 0; i != root_count && same_run; ++i)
+    {
+        warnings.emplace_back( new WarningVisitor(wcout, grouping, summary) );
+
+        for(auto const & shard: shards)
+        {
+            wstring root = shard->get_string();
+            if( roots.size() == i ) roots.push_back(root);
+            else if( roots[i] != root ) same_run = false;
+
+            if( first.kind == CHECK_RESULTS ) warnings[i]->merge(*shard);
+            else tags[i].merge_tags(*shard);
+        }
+    }
+
+    if( !same_run )
+    {
+        wcerr << "the results are not of the shards of one run\n";
+        return 1;
+    }
+
+    if( first.kind == CHECK_RESULTS )
+    {
+        for(std::size_t i = 0; i != roots.size(); ++i)
+        {
+            if( roots.size() > 1 ) wcout << (i ? "\n" : "") << roots[i].wstring() << ":\n";
+            warnings[i]->report();
+        }
+    }
+    else
+    {
+        PrintTagsVisitor combined;
+        for(auto const & t: tags) combined.add_tags(t);
+
+        print_tags_of_roots(roots, tags, combined);
+    }
+
+    return 0;
+}
+
+int heal_main(int, char **)
+{
+    CleanStore store;
+    store.load(".");
+
+    HealerVisitor visitor;
+    visitor.remember(store);
+    visitor.run(".");
+
+    save_clean_store(store, ".");
+
+    return 0;
+}
+
+// Removes CRs from all the notes, in parallel and without asking.
+/*
+Strips the line ends of all the notes, in parallel and without asking:
+the CRs before an LF are removed, the others kept, see strip_cr_block().
+*/
+int heal_eol_main(int, char **)
+{
+    FileListVisitor visitor;
+    visit(".", visitor);
+
+    // Only the notes: the other files may well be binary.
+    vector<File> files;
+    for(auto const & file: visitor.files)
+    {
+        if( has_note_extension(file.filename) ) files.push_back(file);
+    }
+
+    vector<char> repaired(files.size());
+    vector<std::string> errors(files.size());
+
+    parallel_for(files.size(), [&](std::size_t i)
+    {
+        try
+        {
+            repaired[i] = strip_cr(files[i].filename);
+        }
+        catch(IOStreamError const & error)
+        {
+            errors[i] = error.what();
+        }
+    });
+
+    for(std::size_t i = 0; i != files.size(); ++i)
+    {
+        if( !errors[i].empty() ) std::cerr << errors[i] << "\n";
+        if( repaired[i] ) wcout << files[i].filename.wstring() << ": CR LF turned into LF\n";
+    }
+
+    return 0;
+}
+
+int search_main(int argc, char ** argv)
+{
+    // Terms are searched as one phrase, like search_notes does.
+    wstring term;
+    for(int i = 2; i < argc; ++i)
+    {
+        if( !term.empty() ) term += L' ';
+        term += widen(argv[i]);
+    }
+
+    if( ask_server(L"search " + term) ) return 0;
+
+    SearchVisitor visitor(term);
+    visit(".", visitor);
+
+    return 0;
+}
+
+int find_main(int argc, char ** argv)
+{
+    wstring query;
+    for(int i = 2; i < argc; ++i)
+    {
+        if( !query.empty() ) query += L' ';
+        query += widen(argv[i]);
+    }
+
+    if( ask_server(L"find " + query) ) return 0;
+
+    FindVisitor visitor;
+    if( !find_index_from_snapshot(".", visitor.index) )
+    {
+        visit(".", visitor);
+    }
+
+    for(auto const & fn: visitor.index.find(query))
+    {
+        wcout << fn.wstring() << '\n';
+    }
+
+    return 0;
+}
+
+int links_main(int, char **)
+{
+    LinksVisitor visitor;
+    visit(".", visitor);
+    visitor.graph.print(wcout);
+
+    return 0;
+}
+
+int query_main(int argc, char ** argv)
+{
+    bool cooccur = std::string(argv[2]) == "--cooccur";
+
+    wstring expression;
+    for(int i = cooccur ? 3 : 2; i < argc; ++i)
+    {
+        expression += widen(argv[i]) + L' ';
+    }
+
+    QueryVisitor visitor;
+    visit(".", visitor);
+
+    if( cooccur ) visitor.print_cooccurrences(expression);
+    else visitor.print_notes(expression);
+
+    return 0;
+}
+
+int export_main(int argc, char ** argv)
+{
+    bool with_body = false;
+
+    for(int i = 2; i < argc; ++i)
+    {
+        std::string arg(argv[i]);
+
+        if( arg == "--body" ) 
+        {
+            with_body = true;
+        }
+        else if( arg != "--ndjson" )
+        {
+            wcerr << "invalid export option, try \"--help\"\n";
+            return 1;
+        }
+    }
+
+    ExportVisitor visitor(std::cout, with_body);
+    visit(".", visitor);
+    std::cout.flush();
+
+    return 0;
+}
+
+int dupes_main(int argc, char ** argv)
+{
+    // Minimum estimated similarity of near duplicates, in percent.
+    double threshold = 0.8;
+
+    if( argc == 3 )
+    {
+        threshold = std::atoi(argv[2]) / 100.0;
+
+        if( threshold <= 0 || threshold > 1 )
+        {
+            wcerr << "invalid similarity, try \"--help\"\n";
+            return 1;
+        }
+    }
+
+    DupesVisitor visitor(threshold);
+    visit(".", visitor);
+    visitor.print();
+
+    return 0;
+}
+
+/*
+What "retag" does to a note: its tags field, its name and its annex
+directory, for those that have the old tags.
+*/
+struct RetagStep
+{
+    path filename;
+    bool tags_field = false;
+    path renamed;           // empty if the name stays
+    path annex;             // empty if no annex to rename
+    path renamed_annex;
+};
+
+/*
+The steps of a retag, from the snapshot: only the notes that have one
+of the old tags, in their tags field or as the sphere or project of 
+their name.  Throws if a new name is taken.
+*/
+vector<RetagStep> plan_retag(path const & root, Snapshot const & snapshot,
+    set<wstring> const & olds, wstring const & replacement)
+{
+    set<uint32_t> ids;
+    for(auto const & tag: olds) ids.insert( snapshot.find(tag) );
+    ids.erase(NO_STRING);
+
+    uint32_t const * spheres  = snapshot.column(NOTE_SPHERES);
+    uint32_t const * projects = snapshot.column(NOTE_PROJECTS);
+    uint32_t const * begins   = snapshot.column(NOTE_TAG_BEGINS);
+    uint32_t const * tags     = snapshot.column(TAGS);
+
+    vector<RetagStep> steps;
+
+    for(uint32_t i = 0; i != snapshot.note_count() && !ids.empty(); ++i)
+    {
+        RetagStep step;
+        step.filename = root / snapshot.string(NOTE_FILENAMES, i);
+
+        for(uint32_t t = begins[i]; t != begins[i + 1]; ++t)
+        {
+            if( ids.count(tags[t]) ) step.tags_field = true;
+        }
+
+        bool sphere  = ids.count(spheres [i]) != 0;
+        bool project = ids.count(projects[i]) != 0;
+
+        if( sphere || project )
+        {
+            // The tags of the name, without their "#".
+            wstring stem = 
+                (sphere  ? replacement : snapshot.string(spheres [i])).substr(1) + L' ' +
+                (project ? replacement : snapshot.string(projects[i])).substr(1) + L' ' +
+                snapshot.string(NOTE_SUBJECTS, i);
+
+            step.renamed = root / (stem + step.filename.extension().wstring());
+
+            // From the disk, not the snapshot: an annex moves with its
+            // note even if it was made after the snapshot.
+            path annex = root / step.filename.stem();
+            if( is_directory(annex) )
+            {
+                step.annex = annex;
+                step.renamed_annex = root / stem;
+            }
+        }
+
+        if( step.tags_field || !step.renamed.empty() ) steps.push_back(step);
+    }
+
+    std::sort(steps.begin(), steps.end(), [](RetagStep const & a, RetagStep const & b)
+    {
+        return a.filename < b.filename;
+    });
+
+    // A name can be taken by a note that keeps it, or that another
+    // note takes too.
+    set<path> leaving;
+    for(auto const & step: steps)
+    {
+        if( !step.renamed.empty() ) leaving.insert(step.filename);
+        if( !step.annex.empty() ) leaving.insert(step.annex);
+    }
+
+    set<path> taken;
+    for(auto const & step: steps)
+    {
+        for(auto const & p: {step.renamed, step.renamed_annex})
+        {
+            if( p.empty() ) continue;
+
+            if( !taken.insert(p).second || (exists(p) && !leaving.count(p)) )
+            {
+                throw std::runtime_error("cannot rename to \"" + p.string() + 
+                    "\": the name is taken");
+            }
+        }
+    }
+
+    return steps;
+}
+
+// Rewrites the tags field of the note, then renames it and its annex.
+void apply_retag(RetagStep const & step, set<wstring> const & olds,
+    wstring const & replacement)
+{
+    if( step.tags_field )
+    {
+        Note note{ File(step.filename) };
+
+        std::size_t before = note.tags.size();
+        for(auto const & tag: olds) note.tags.erase(tag);
+
+        if( note.tags.size() != before )
+        {
+            note.tags.insert(replacement);
+            note.header[TAG_FIELD_NAME] = print_tags(note.tags);
+            note.write();
+        }
+    }
+
+    if( !step.renamed.empty() ) boost::filesystem::rename(step.filename, step.renamed);
+    if( !step.annex.empty() ) boost::filesystem::rename(step.annex, step.renamed_annex);
+}
+
+int snapshot_main(int, char **)
+{
+    SnapshotUpdater updater(".");
+    visit(".", updater);
+    updater.write(".");
+    return 0;
+}
+
+int where_main(int argc, char ** argv)
+{
+    vector< std::pair<wstring, wstring> > conditions;
+    for(int i = 2; i != argc; ++i)
+    {
+        wstring arg = widen(argv[i]);
+        auto equal = arg.find(L'=');
+        if( equal == wstring::npos || equal == 0 )
+        {
+            wcerr << "invalid condition \"" << arg << "\", expected FIELD=VALUE\n";
+            return 1;
+        }
+        conditions.emplace_back( boost::algorithm::trim_copy(arg.substr(0, equal)),
+            boost::algorithm::trim_copy(arg.substr(equal + 1)) );
+    }
+
+    Snapshot snapshot;
+    open_snapshot(".", snapshot);
+    print_where_from_snapshot(wcout, ".", snapshot, conditions);
+    return 0;
+}
+
+/*
+Arguments: [--dry-run] OLD... NEW.  The old tags of the notes become
+the new one, in their tags field and in their name, annex included:
+one old tag renames, several merge.
+*/
+int retag_main(int argc, char ** argv)
+{
+    bool dry_run = false;
+    vector<wstring> args;
+
+    for(int i = 2; i != argc; ++i)
+    {
+        wstring arg = widen(argv[i]);
+        if( arg == L"--dry-run" ) dry_run = true;
+        else args.push_back( nfc(arg[0] == L'#' ? arg : L'#' + arg) );
+    }
+
+    for(auto const & tag: args)
+    {
+        if( !is_tag(tag) || tag.find(L'/') != wstring::npos )
+        {
+            wcerr << "invalid tag \"" << tag << "\"\n";
+            return 1;
+        }
+    }
+
+    if( args.size() < 2 )
+    {
+        wcerr << "expected old tags and the new one, try \"--help\"\n";
+        return 1;
+    }
+
+    wstring replacement = args.back();
+    set<wstring> olds(args.begin(), args.end() - 1);
+    olds.erase(replacement);
+
+    // A dry run does not write to the vault, not even the snapshot.
+    Snapshot snapshot;
+    open_snapshot(".", snapshot, !dry_run);
+
+    vector<RetagStep> steps;
+    try
+    {
+        steps = plan_retag(".", snapshot, olds, replacement);
+    }
+    catch(std::runtime_error const & error)
+    {
+        wcerr << widen(error.what()) << '\n';
+        return 1;
+    }
+
+    for(auto const & step: steps)
+    {
+        if( step.tags_field ) 
+            wcout << "retag " << step.filename.wstring() << '\n';
+        if( !step.renamed.empty() ) 
+            wcout << "rename " << step.filename.wstring() << " -> " << step.renamed.wstring() << '\n';
+        if( !step.annex.empty() ) 
+            wcout << "rename " << step.annex.wstring() << " -> " << step.renamed_annex.wstring() << '\n';
+    }
+
+    if( dry_run ) return 0;
+
+    // The notes do not share anything: each thread takes its own.
+    vector<std::string> errors(steps.size());
+    parallel_for(steps.size(), [&](std::size_t i)
+    {
+        try
+        {
+            apply_retag(steps[i], olds, replacement);
+        }
+        catch(std::exception const & error)
+        {
+            errors[i] = error.what();
+        }
+    });
+
+    int r = 0;
+    for(auto const & error: errors)
+    {
+        if( error.empty() ) continue;
+        wcerr << "error: " << widen(error) << '\n';
+        r = 1;
+    }
+
+    return r;
+}
+
+int fields_main(int argc, char ** argv)
+{
+    optional<wstring> field;
+    if( argc == 3 ) field = widen(argv[2]);
+
+    Snapshot snapshot;
+    open_snapshot(".", snapshot);
+    print_fields_from_snapshot(wcout, snapshot, field);
+    return 0;
+}
+
+int lacking_main(int, char ** argv)
+{
+    wstring field = widen(argv[2]);
+
+    if( print_lacking_from_snapshot(".", field) ) return 0;
+
+    LackingFieldVisitor visitor(field);
+    visit(".", visitor);
+    return 0;
+}
+
+int serve_main(int, char **)
+{
+    NotesServer server(".");
+    return server.run();
+}
+
+#endif
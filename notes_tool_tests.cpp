@@ -1,5 +1,48 @@
+
+// grindtrick import googletest
+// grindtrick import boost_filesystem
+// grindtrick import boost_system
+
+#include "notes_tool.hpp"
+
 #include <gtest/gtest.h>
 
+#include <random>
+
+// A directory of its own for a test, removed with everything in it.
+class TempDir
+{
+public:
+    TempDir() : path_( boost::filesystem::temp_directory_path() / 
+        boost::filesystem::unique_path("notes_tool_tests_%%%%%%%%") )
+    {
+        boost::filesystem::create_directory(path_);
+    }
+
+    ~TempDir()
+    {
+        boost::filesystem::remove_all(path_);
+    }
+
+    path const & path_of() const { return path_; }
+
+    path write(wstring const & name, std::string const & content) const
+    {
+        path p = path_ / name;
+        std::ofstream(p.string(), std::ios::binary) << content;
+        return p;
+    }
+
+    std::string read(wstring const & name) const
+    {
+        std::ifstream fs((path_ / name).string(), std::ios::binary);
+        return std::string(std::istreambuf_iterator<char>(fs), {});
+    }
+
+private:
+    path path_;
+};
+
 TEST(parse_filename, simple)
 {
     File file(L"./inro desktop The subject.md");
@@ -194,6 +237,31 @@ TEST( parse_note_text, with_fields )
     EXPECT_EQ( n.body, L"Le corps\nest ici.\n" );
 }
 
+TEST( parse_note_text, body_offset )
+{
+    Note n;
+
+    n.parse_text( L"Sujet: le sujet\n\nLe corps\n" );
+    EXPECT_EQ( n.body_offset, std::size_t{17} );
+
+    n.parse_text( L"Sujet: le sujet\nLe corps\n" );
+    EXPECT_EQ( n.body_offset, std::size_t{16} );
+
+    n.parse_text( L"Le corps\n" );
+    EXPECT_EQ( n.body_offset, std::size_t{0} );
+}
+
+TEST( utf8, round_trip )
+{
+    wstring w(L"\u00C9tiquettes #arr\u00EAt \u20AC");
+
+    std::string u = utf8_from_wide(w);
+    EXPECT_EQ( u, "\xC3\x89tiquettes #arr\xC3\xAAt \xE2\x82\xAC" );
+    EXPECT_EQ( wide_from_utf8(u), w );
+
+    EXPECT_EQ( utf8_from_wide(L""), "" );
+}
+
 TEST( parse_tags, empty )
 {
     set<wstring> tags;
@@ -210,6 +278,22 @@ TEST( parse_tags, bad )
     ASSERT_FALSE( parse_tags(L"#hash#hash", tags) );
 }
 
+TEST( parse_tags, bad_tag )
+{
+    set<wstring> tags;
+    wstring bad;
+
+    ASSERT_FALSE( parse_tags(L"#inro desktop #other", tags, &bad) );
+    EXPECT_EQ( bad, L"desktop" );
+    EXPECT_TRUE( tags.empty() );
+
+    ASSERT_FALSE( parse_tags(L"  #inro #", tags, &bad) );
+    EXPECT_EQ( bad, L"#" );
+
+    ASSERT_FALSE( parse_tags(L"#hash#hash\t#ok", tags, &bad) );
+    EXPECT_EQ( bad, L"#hash#hash" );
+}
+
 TEST( parse_tags, valid )
 {
     set<wstring> tags;
@@ -223,6 +307,9 @@ TEST( parse_tags, valid )
     EXPECT_EQ( tags.size(), std::size_t{2} );
     EXPECT_EQ( tags.count(L"#inro"), std::size_t{1} );
     EXPECT_EQ( tags.count(L"#spaces"), std::size_t{1} );
+
+    ASSERT_TRUE( parse_tags(L" #z\t#a  #z ", tags) );
+    EXPECT_EQ( tags, (set<wstring>{L"#a", L"#z"}) );
 }
 
 TEST( is_tag, test )
@@ -234,8 +321,736 @@ TEST( is_tag, test )
     ASSERT_FALSE( is_tag(L"#in ro") ) ;
 }
 
-int tests(int argc, char ** argv)
+TEST( json_string, escapes )
+{
+    EXPECT_EQ( json_string(L"simple"), "\"simple\"" );
+    EXPECT_EQ( json_string(L"a \"b\" \\ c\n"), "\"a \\\"b\\\" \\\\ c\\n\"" );
+    EXPECT_EQ( json_string(L"\x01"), "\"\\u0001\"" );
+    EXPECT_EQ( json_string(L"Arr\u00EAt"), "\"Arr\xC3\xAAt\"" );
+    EXPECT_EQ( json_string(optional<wstring>()), "null" );
+}
+
+TEST( xxhash64, reference )
+{
+    EXPECT_EQ( xxhash64(""), 0xEF46DB3751D8E999ull );
+    EXPECT_EQ( xxhash64("a"), 0xD24EC4F1A98C6E5Bull );
+    EXPECT_EQ( xxhash64("abc"), 0x44BC2CF5AD770999ull );
+    EXPECT_EQ( xxhash64("Nobody inspects the spammish repetition"), 0xFBCEA83C8A378BF1ull );
+}
+
+TEST( MinHash, similarity )
 {
+    wstring text(L"Le projet est arr\u00EAt\u00E9 parce que le budget est "
+        L"\u00E9puis\u00E9 et que personne ne veut plus le financer cette ann\u00E9e");
+
+    MinHash a(text);
+    MinHash b(text + L" du tout");
+    MinHash c(L"Rien \u00E0 voir avec l'autre note, sinon quelques mots communs");
+
+    EXPECT_EQ( a.similarity(a), 1.0 );
+    EXPECT_GT( a.similarity(b), 0.6 );
+    EXPECT_LT( a.similarity(c), 0.2 );
+}
+
+TEST( TagBitmap, operations )
+{
+    TagBitmap a, b;
+
+    for(uint32_t i = 0; i < 200000; i += 2) a.add(i);
+    for(uint32_t i = 0; i < 200000; i += 3) b.add(i);
+    b.add(7);
+
+    EXPECT_EQ( a.count(), std::size_t{100000} );
+    EXPECT_TRUE( a.contains(70000) );
+    EXPECT_FALSE( a.contains(70001) );
+    EXPECT_TRUE( b.contains(7) );
+
+    EXPECT_EQ( (a & b).count(), std::size_t{33334} );
+    EXPECT_EQ( (a | b).count(), std::size_t{133334} );
+    EXPECT_EQ( (a - b).count(), std::size_t{66666} );
+    EXPECT_TRUE( (a & b).contains(6) );
+    EXPECT_FALSE( (a - b).contains(6) );
+
+    vector<uint32_t> ids;
+    (b - a).for_each( [&](uint32_t id) { if( id < 10 ) ids.push_back(id); } );
+    EXPECT_EQ( ids, (vector<uint32_t>{3, 7, 9}) );
+}
+
+TEST( TagBitmap, container_kinds )
+{
+    // Arrays and bit sets, in every pair, against std::set.
+    std::mt19937 random(42);
+    vector< set<uint32_t> > sets;
+    for(uint32_t n: {0u, 10u, 3000u, 5000u, 30000u})
+    {
+        set<uint32_t> s;
+        while( s.size() != n ) s.insert(random() % 70000);
+        sets.push_back(s);
+    }
+
+    auto bitmap = [](set<uint32_t> const & s)
+    {
+        TagBitmap r;
+        for(auto id: s) r.add(id);
+        return r;
+    };
+
+    auto ids = [](TagBitmap const & b)
+    {
+        set<uint32_t> r;
+        b.for_each( [&](uint32_t id) { r.insert(id); } );
+        return r;
+    };
+
+    for(auto const & x: sets)
+    {
+        for(auto const & y: sets)
+        {
+            set<uint32_t> both, either, only;
+            std::set_intersection(x.begin(), x.end(), y.begin(), y.end(), std::inserter(both, both.end()));
+            std::set_union(x.begin(), x.end(), y.begin(), y.end(), std::inserter(either, either.end()));
+            std::set_difference(x.begin(), x.end(), y.begin(), y.end(), std::inserter(only, only.end()));
+
+            EXPECT_EQ( ids(bitmap(x) & bitmap(y)), both );
+            EXPECT_EQ( ids(bitmap(x) | bitmap(y)), either );
+            EXPECT_EQ( ids(bitmap(x) - bitmap(y)), only );
+        }
+    }
+}
+
+TEST( TagIndex, query )
+{
+    TagIndex index;
+
+    auto add = [&](wchar_t const * fn, wchar_t const * tags)
+    {
+        Note n;
+        n.file = File(fn);
+        parse_filename(n.file, n.name);
+        parse_tags(tags, n.tags);
+        index.add(n);
+    };
+
+    add(L"work infra A.md",    L"#urgent");
+    add(L"work infra B.md",    L"#archived");
+    add(L"home projectX C.md", L"#infra");
+    add(L"home perso D.md",    L"#Arr\u00EAt");
+
+    EXPECT_EQ( index.query(L"#work").count(), std::size_t{2} );
+    EXPECT_EQ( index.query(L"#infra !#archived").count(), std::size_t{2} );
+    EXPECT_EQ( index.query(L"#infra and not #archived and #work").count(), std::size_t{1} );
+    EXPECT_EQ( index.query(L"#projectX | #urgent").count(), std::size_t{2} );
+    EXPECT_EQ( index.query(L"-(#work | #home)").count(), std::size_t{0} );
+    EXPECT_EQ( index.query(L"#unknown").count(), std::size_t{0} );
+
+    // Typed decomposed, found composed.
+    EXPECT_EQ( index.query(L"#Arre\u0302t").count(), std::size_t{1} );
+
+    EXPECT_THROW( index.query(L"#work &"), std::invalid_argument );
+    EXPECT_THROW( index.query(L"(#work"), std::invalid_argument );
+    EXPECT_THROW( index.query(L"work"), std::invalid_argument );
+}
+
+TEST( IgnoreRules, regex )
+{
+    IgnoreRules rules;
+    rules.add_regex(L".*\\.bak");
+
+    EXPECT_TRUE( rules.ignored(L"a.bak", false) );
+    EXPECT_FALSE( rules.ignored(L"a.bak.md", false) );
+}
+
+TEST( IgnoreRules, glob )
+{
+    IgnoreRules rules;
+    rules.add_glob(L"*.bak");
+    rules.add_glob(L"!keep.bak");
+    rules.add_glob(L"exports/");
+    rules.add_glob(L"/site/old");
+    rules.add_glob(L"a/**/b");
+    rules.add_glob(L"n?te[0-9]");
+
+    EXPECT_TRUE( rules.ignored(L"x.bak", false) );
+    EXPECT_TRUE( rules.ignored(L"annex/x.bak", false) );
+    EXPECT_FALSE( rules.ignored(L"keep.bak", false) );
+
+    EXPECT_TRUE( rules.ignored(L"exports", true) );
+    EXPECT_FALSE( rules.ignored(L"exports", false) );
+
+    EXPECT_TRUE( rules.ignored(L"site/old", true) );
+    EXPECT_FALSE( rules.ignored(L"x/site/old", true) );
+
+    EXPECT_TRUE( rules.ignored(L"a/b", true) );
+    EXPECT_TRUE( rules.ignored(L"a/x/y/b", true) );
+
+    EXPECT_TRUE( rules.ignored(L"note1", false) );
+    EXPECT_FALSE( rules.ignored(L"note", false) );
+    EXPECT_FALSE( rules.ignored(L"inro desktop Sujet.md", false) );
+}
+
+TEST( IgnoreRules, regex_from_glob )
+{
+    EXPECT_EQ( IgnoreRules::regex_from_glob(L"*.md"), L"[^/]*\\.md" );
+    EXPECT_EQ( IgnoreRules::regex_from_glob(L"[!a]?"), L"[^a][^/]" );
+    EXPECT_EQ( IgnoreRules::regex_from_glob(L"**/x(1)"), L"(.*/)?x\\(1\\)" );
+}
+
+TEST( fold, accents_and_case )
+{
+    EXPECT_EQ( fold(L"Arrêt DU Projet"), L"arret du projet" );
+    EXPECT_EQ( fold(L"Œuvre ßÇ"), L"ouvre sc" );
+    EXPECT_EQ( fold(L"e\u0301te\u0301"), L"ete" );
+}
+
+TEST( nfc, compose )
+{
+    EXPECT_EQ( nfc(L"Arret"), L"Arret" );
+    EXPECT_EQ( nfc(L"Arre\u0302t"), L"Arr\u00EAt" );
+    EXPECT_EQ( nfc(L"Arr\u00EAt"), L"Arr\u00EAt" );
+
+    // Two marks: the one of lower class first, both composed.
+    EXPECT_EQ( nfc(L"e\u0302\u0323"), L"\u1EC7" );
+    EXPECT_EQ( nfc(L"e\u0323\u0302"), L"\u1EC7" );
+
+    // Blocked by a mark of the same class.
+    EXPECT_EQ( nfc(L"a\u0301\u0301"), L"\u00E1\u0301" );
+
+    // Singletons, and composites that are not composed again.
+    EXPECT_EQ( nfc(L"\u212B"), L"\u00C5" );
+    EXPECT_EQ( nfc(L"\u2126"), L"\u03A9" );
+    EXPECT_EQ( nfc(L"a\u0340"), L"\u00E0" );
+    EXPECT_EQ( nfc(L"\u0958"), L"\u0915\u093C" );
+    EXPECT_EQ( nfc(L"\uF900"), L"\u8C48" );
+
+    set<wstring> tags;
+    ASSERT_TRUE( parse_tags(L"#Arr\u00EAt #Arre\u0302t", tags) );
+    EXPECT_EQ( tags.size(), 1u );
+}
+
+TEST( fold_case, simple )
+{
+    EXPECT_EQ( fold_case(wstring(L"Quit")), L"quit" );
+    EXPECT_EQ( fold_case(wstring(L"\u00C9T\u00C9 \u0100\u0101 \u03A3\u03C2")), 
+        L"\u00E9t\u00E9 \u0101\u0101 \u03C3\u03C3" );
+}
+
+TEST( FindIndex, ranking )
+{
+    FindIndex index;
+    index.add(L"inro desktop Arrêt du projet.md", wstring(L"inro"), wstring(L"desktop"),
+        wstring(L"Arrêt du projet"), boost::none);
+    index.add(L"work infra Server.md", wstring(L"work"), wstring(L"infra"),
+        wstring(L"Server"), wstring(L"Serveur de build"));
+    index.add(L"work infra Serveur.md", wstring(L"work"), wstring(L"infra"),
+        wstring(L"Serveur"), boost::none);
+
+    EXPECT_EQ( index.find(L"arret"), vector<path>{L"inro desktop Arrêt du projet.md"} );
+    EXPECT_EQ( index.find(L"ARRET PROJET"), vector<path>{L"inro desktop Arrêt du projet.md"} );
+    EXPECT_EQ( index.find(L"zzz").size(), std::size_t{0} );
+    EXPECT_EQ( index.find(L"arrt du projet"), vector<path>{L"inro desktop Arrêt du projet.md"} );
+
+    // Exact matches before approximate ones, shorter keys first.
+    EXPECT_EQ( index.find(L"serveur"), 
+        (vector<path>{L"work infra Serveur.md", L"work infra Server.md"}) );
+    EXPECT_EQ( index.find(L"build"), vector<path>{L"work infra Server.md"} );
+
+    EXPECT_EQ( FindIndex::substring_distance(L"abc", L"xxabxcxx"), std::size_t{1} );
+    EXPECT_TRUE( FindIndex::is_subsequence(L"prjt", L"projet") );
+}
+
+TEST( extract_links, markdown )
+{
+    wstring body = 
+        L"See [a](work infra Server.md) and ![img](Server/x%20y.png \"title\").\n"
+        L"[web](https://example.com) [top](#part) [abs](/etc/passwd)\n"
+        L"`[code](code.md)` [b](<./other note.md#part>)\n"
+        L"```\n"
+        L"[fenced](fenced.md)\n"
+        L"```\n"
+        L"[ref]: ../up.md\n";
+
+    EXPECT_EQ( extract_links(body), (vector<wstring>{
+        L"work infra Server.md", L"Server/x y.png", L"other note.md", L"../up.md" }) );
+
+    EXPECT_TRUE( extract_links(L"no links (here)\n").empty() );
+}
+
+TEST( resolve_link, listing )
+{
+    Listing listing;
+    listing.directory = L"/nonexistent";
+    listing.add_file(L"a b d.md");
+    listing.add_file(L"a b c.md");
+    listing.sort_files();
+    listing.annexes = { L"a b d" };
+
+    EXPECT_EQ( resolve_link(listing, L"a b c.md").kind, LINK_NOTE );
+    EXPECT_EQ( resolve_link(listing, L"a b d").kind, LINK_ANNEX_FILE );
+    EXPECT_EQ( resolve_link(listing, L"a b d/x.png").kind, LINK_MISSING_ANNEX_FILE );
+    EXPECT_EQ( resolve_link(listing, L"a b d/x.png").name, L"a b d" );
+    EXPECT_EQ( resolve_link(listing, L"a b e.md").kind, LINK_BROKEN );
+}
+
+TEST( MemorySource, check )
+{
+    auto source = std::make_shared<MemorySource>();
+    source->add_file(L"inro desktop Sujet.md", 
+        "Sujet: Sujet\n\u00C9tiquettes: #inro #desktop\n\n[x](inro%20desktop%20Sujet/x.png)\n");
+    source->add_file(L"inro desktop Sujet/x.png", "png");
+    source->add_file(L"inro desktop Autre.md", 
+        "Sujet: Autre\n\u00C9tiquettes: #inro #desktop\n\nline\r\n[y](y.md)\n");
+    source->add_directory(L"orphan");
+    source->add_file(L".notesignore", "ignored\n");
+    source->add_directory(L"ignored");
+
+    std::wostringstream out;
+    WarningVisitor visitor(out);
+    visit(source, visitor, load_ignore(*source));
+    visitor.report();
+
+    EXPECT_EQ( out.str(), 
+        L"warning: orphan directory found: memory/orphan\n"
+        L"warning(memory/inro desktop Autre.md): CR detected\n"
+        L"warning(memory/inro desktop Autre.md): broken link: \"y.md\"\n" );
+}
+
+TEST( WarningVisitor, unique )
+{
+    auto source = std::make_shared<MemorySource>();
+    source->add_file(L"inro desktop Sujet.md", "Sujet: Sujet\n\u00C9tiquettes: #inro #desktop\n\n");
+    source->add_file(L"work infra sujet.md",   "Sujet: sujet\n\u00C9tiquettes: #work #infra\n\n");
+    source->add_file(L"work infra Autre.md",   "Sujet: Autre\n\u00C9tiquettes: #work #infra\n\n");
+    source->add_file(L"work infra autre.md",   "Sujet: autre\n\u00C9tiquettes: #work #infra\n\n");
+
+    std::wostringstream out;
+    WarningVisitor visitor(out, WarningVisitor::BY_CHECK);
+    visit(source, visitor, load_ignore(*source));
+    visitor.report();
+
+    EXPECT_EQ( out.str(), 
+        L"\nduplicate_subject:\n"
+        L"  warning(memory/inro desktop Sujet.md): same subject as \"work infra sujet.md\"\n"
+        L"  warning(memory/work infra Autre.md): same subject as \"work infra autre.md\"\n"
+        L"  warning(memory/work infra autre.md): same subject as \"work infra Autre.md\"\n"
+        L"  warning(memory/work infra sujet.md): same subject as \"inro desktop Sujet.md\"\n"
+        L"\nfilename_clash:\n"
+        L"  warning(memory/work infra Autre.md): filename clashes with \"work infra autre.md\"\n"
+        L"  warning(memory/work infra autre.md): filename clashes with \"work infra Autre.md\"\n" );
+}
+
+TEST( WarningVisitor, unique_changed )
+{
+    auto source = std::make_shared<MemorySource>();
+    source->add_file(L"inro desktop Sujet.md", "Sujet: Sujet\n\u00C9tiquettes: #inro #desktop\n\n");
+    source->add_file(L"work infra sujet.md",   "Sujet: sujet\n\u00C9tiquettes: #work #infra\n\n");
+    source->add_file(L"work infra Autre.md",   "Sujet: Autre\n\u00C9tiquettes: #work #infra\n\n");
+    source->add_file(L"work infra autre.md",   "Sujet: autre\n\u00C9tiquettes: #work #infra\n\n");
+
+    // Only a new note changed: compared to all, but only its group
+    // is reported.
+    set<wstring> only{ L"work infra sujet" };
+
+    std::wostringstream out;
+    WarningVisitor visitor(out, WarningVisitor::BY_CHECK);
+    visit(source, visitor, load_ignore(*source), &only);
+    visitor.report();
+
+    EXPECT_EQ( out.str(), 
+        L"\nduplicate_subject:\n"
+        L"  warning(memory/inro desktop Sujet.md): same subject as \"work infra sujet.md\"\n"
+        L"  warning(memory/work infra sujet.md): same subject as \"inro desktop Sujet.md\"\n" );
+}
+
+TEST( load_pipeline, throwing )
+{
+    // More files than the queue holds: the loader must not be left
+    // waiting on a full queue.
+    auto source = std::make_shared<MemorySource>();
+    for(int i = 0; i != 1000; ++i)
+    {
+        source->add_file(L"a b " + std::to_wstring(i) + L".md", "Sujet: x\n\n");
+    }
+
+    FileListVisitor visitor;
+    visit(source, visitor, load_ignore(*source));
+
+    vector<File const *> files;
+    for(auto const & file: visitor.files) files.push_back(&file);
+
+    EXPECT_THROW( load_pipeline(files, [](std::size_t, Note const &)
+    {
+        throw std::runtime_error("parse");
+    }), std::runtime_error );
+}
+
+TEST( ScanOptions, parse )
+{
+    vector<wstring> args{ L"--max-memory", L"64M", L"--stats", L"--max-memory", L"2X" };
+    ScanOptions options;
+
+    std::size_t i = 0;
+    EXPECT_TRUE( parse_scan_option(args, i, options) );
+    EXPECT_EQ( i, std::size_t{1} );
+    EXPECT_EQ( options.max_memory, std::size_t{64} << 20 );
+    EXPECT_EQ( options.batch_size(), std::size_t{16384} );
+
+    i = 2;
+    EXPECT_TRUE( parse_scan_option(args, i, options) );
+    EXPECT_TRUE( options.stats );
+
+    i = 3;
+    EXPECT_FALSE( parse_scan_option(args, i, options) );
+
+    EXPECT_EQ( ScanOptions().batch_size(), std::numeric_limits<std::size_t>::max() );
+}
+
+TEST( ScanOptions, shards )
+{
+    vector<wstring> args{ L"--shard", L"2/3", L"--shard", L"4/3", L"--shard", L"1/2x" };
+    ScanOptions options;
+
+    EXPECT_TRUE( options.in_shard(L"./a b c.md") );
+
+    std::size_t i = 0;
+    EXPECT_TRUE( parse_scan_option(args, i, options) );
+    EXPECT_EQ( options.shard, 2u );
+    EXPECT_EQ( options.shards, 3u );
+
+    i = 2;
+    EXPECT_FALSE( parse_scan_option(args, i, options) );
+    i = 4;
+    EXPECT_FALSE( parse_scan_option(args, i, options) );
+
+    // Each note in exactly one shard, wherever the root is.
+    for(wstring name: {L"a b c.md", L"x y z.md", L"inro desktop Arr\u00EAt.md"})
+    {
+        int in = 0;
+        for(options.shard = 1; options.shard <= options.shards; ++options.shard)
+        {
+            bool here = options.in_shard(L"./" + name);
+            EXPECT_EQ( here, options.in_shard(L"/notes/" + name) );
+            in += here;
+        }
+        EXPECT_EQ( in, 1 );
+    }
+}
+
+TEST( strip_cr, pairs_only )
+{
+    TempDir dir;
+
+    dir.write(L"crlf.md", "a\r\nb\r\n");
+    EXPECT_TRUE( strip_cr(dir.path_of() / L"crlf.md") );
+    EXPECT_EQ( dir.read(L"crlf.md"), "a\nb\n" );
+
+    dir.write(L"lone.md", "a\rb\r");
+    EXPECT_FALSE( strip_cr(dir.path_of() / L"lone.md") );
+    EXPECT_EQ( dir.read(L"lone.md"), "a\rb\r" );
+
+    // All the CRs before an LF: once stripped, nothing is left to strip.
+    dir.write(L"mixed.md", "\r\r\na\rb\r\n\r");
+    EXPECT_TRUE( strip_cr(dir.path_of() / L"mixed.md") );
+    EXPECT_EQ( dir.read(L"mixed.md"), "\na\rb\n\r" );
+    EXPECT_FALSE( strip_cr(dir.path_of() / L"mixed.md") );
+
+    // In memory, by the same rule.
+    EXPECT_EQ( strip_cr(std::string("\r\r\na\rb\r\n\r")), "\na\rb\n\r" );
+
+    dir.write(L"none.md", "a\nb\n");
+    EXPECT_FALSE( strip_cr(dir.path_of() / L"none.md") );
+    EXPECT_EQ( dir.read(L"none.md"), "a\nb\n" );
+    EXPECT_FALSE( exists(dir.path_of() / L"none.md.eol.tmp") );
+
+    // The CR ends the first block of 64 KiB, the LF starts the next.
+    std::string big(64 * 1024 - 1, 'x');
+    dir.write(L"split.md", big + "\r\ny");
+    EXPECT_TRUE( strip_cr(dir.path_of() / L"split.md") );
+    EXPECT_EQ( dir.read(L"split.md"), big + "\ny" );
+
+    dir.write(L"split_lone.md", big + "\ry\r\n");
+    EXPECT_TRUE( strip_cr(dir.path_of() / L"split_lone.md") );
+    EXPECT_EQ( dir.read(L"split_lone.md"), big + "\ry\n" );
+}
+
+TEST( EolCheck, same_rule_as_strip_cr )
+{
+    File file(L"./a b c.md");
+    EXPECT_FALSE( EolCheck( Note(file, "Sujet: c\n\nbody\rmore\r\n") ) );
+    EXPECT_TRUE( EolCheck( Note(file, "Sujet: c\n\nbody\rmore\n") ) );
+    EXPECT_TRUE( EolCheck( Note(file, strip_cr(std::string("Sujet: c\n\nbody\r\r\n"))) ) );
+}
+
+TEST( HealerVisitor, all )
+{
+    TempDir dir;
+
+    // More notes than the threads keep ahead of the prompts.
+    for(int i = 0; i != 200; ++i)
+    {
+        std::string n = std::to_string(i);
+        dir.write(L"a b " + widen(n) + L".md", 
+            "Sujet: " + n + "\r\n\u00C9tiquettes: #a #b\r\n\r\nline\r\n");
+    }
+    dir.write(L"a b Deux.md", "\u00C9tiquettes: #a #b\n\nline\n");
+    // Rewritten or only stripped, the same CRs go.
+    dir.write(L"a b Trois.md", "\u00C9tiquettes: #a #b\r\n\r\nx\ry\r\n");
+    dir.write(L"a b Quatre.md", "Sujet: Quatre\n\u00C9tiquettes: #a #b\r\n\r\nx\ry\r\n");
+    dir.write(L"a b Clean.md", "Sujet: Clean\n\u00C9tiquettes: #a #b\n\nline\n");
+
+    std::wistringstream in(L"all\n");
+    std::wostringstream out;
+    auto in_buf = wcin.rdbuf(in.rdbuf());
+    auto out_buf = wcout.rdbuf(out.rdbuf());
+
+    HealerVisitor healer;
+    healer.run(dir.path_of());
+
+    wcin.rdbuf(in_buf);
+    wcout.rdbuf(out_buf);
+
+    EXPECT_EQ( dir.read(L"a b 0.md"),   "Sujet: 0\n\u00C9tiquettes: #a #b\n\nline\n" );
+    EXPECT_EQ( dir.read(L"a b 199.md"), "Sujet: 199\n\u00C9tiquettes: #a #b\n\nline\n" );
+    EXPECT_EQ( dir.read(L"a b Deux.md"), "\u00C9tiquettes: #a #b\nSujet: Deux\n\nline\n" );
+    EXPECT_EQ( dir.read(L"a b Trois.md"), "\u00C9tiquettes: #a #b\nSujet: Trois\n\nx\ry\n" );
+    EXPECT_EQ( dir.read(L"a b Quatre.md"), "Sujet: Quatre\n\u00C9tiquettes: #a #b\n\nx\ry\n" );
+    EXPECT_EQ( dir.read(L"a b Clean.md"), "Sujet: Clean\n\u00C9tiquettes: #a #b\n\nline\n" );
+}
+
+TEST( SnapshotUpdater, where_and_fields )
+{
+    TempDir dir;
+    path const & root = dir.path_of();
+
+    dir.write(L"a b Un.md",    "Sujet: Un\nStatut: ouvert\n\n");
+    dir.write(L"a b Deux.md",  "Sujet: Deux\nStatut: ouvert\n\n");
+    dir.write(L"a b Trois.md", "Sujet: Trois\nStatut: ferm\u00E9\nPriorit\u00E9: haute\n\n");
+
+    Snapshot snapshot;
+    open_snapshot(root, snapshot);
+    EXPECT_TRUE( snapshot.fresh(root) );
+
+    // One note changed, one removed: only the changed one is parsed,
+    // the row of the other is copied.
+    dir.write(L"a b Un.md", "Sujet: Un\nStatut: ferm\u00E9\n\n");
+    boost::filesystem::remove(root / L"a b Deux.md");
+
+    {
+        SnapshotUpdater updater(root);
+        visit(root, updater);
+        EXPECT_EQ( updater.parsed(), 1u );
+        updater.write(root);
+    }
+
+    open_snapshot(root, snapshot);
+    EXPECT_EQ( snapshot.note_count(), 2u );
+
+    std::wostringstream where;
+    print_where_from_snapshot(where, root, snapshot, {{L"Statut", L"ferm\u00E9"}});
+    // In the order of the directory.
+    set<wstring> found;
+    std::wistringstream lines(where.str());
+    for(wstring line; getline(lines, line); ) found.insert(line);
+    EXPECT_EQ( found, (set<wstring>{ (root / L"a b Trois.md").wstring(), 
+        (root / L"a b Un.md").wstring() }) );
+
+    std::wostringstream none;
+    print_where_from_snapshot(none, root, snapshot, {{L"Statut", L"ouvert"}});
+    EXPECT_EQ( none.str(), L"" );
+
+    std::wostringstream fields;
+    print_fields_from_snapshot(fields, snapshot, boost::none);
+    EXPECT_EQ( fields.str(), 
+        L"Fields:\n"
+        L"  Priorit\u00E9                 1 notes     1 values\n"
+        L"  Statut                   2 notes     1 values\n"
+        L"  Sujet                    2 notes     2 values\n" );
+}
+
+TEST( DupesVisitor, identical )
+{
+    TempDir dir;
+    dir.write(L"a b Un.md",    "Sujet: Un\n\nle corps de la note\n");
+    dir.write(L"a b Deux.md",  "Sujet: Deux\n\nle corps de la note\n");
+    dir.write(L"a b Trois.md", "Sujet: Trois\n\ntout autre chose ici\n");
+
+    std::wostringstream out;
+    DupesVisitor visitor(0.8, out);
+    visit(dir.path_of(), visitor);
+    visitor.print();
+
+    wstring root = dir.path_of().wstring();
+    wstring const & text = out.str();
+    EXPECT_EQ( text.find(L"Identical:\n"), 0u );
+    EXPECT_NE( text.find(L"  " + root + L"/a b Un.md\n"), wstring::npos );
+    EXPECT_NE( text.find(L"  " + root + L"/a b Deux.md\n"), wstring::npos );
+    EXPECT_EQ( text.find(L"Trois"), wstring::npos );
+}
+
+TEST( Snapshot, fresh_annex )
+{
+    TempDir dir;
+    path const & root = dir.path_of();
+
+    dir.write(L"a b Un.md", "Sujet: Un\n\n");
+
+    Snapshot snapshot;
+    open_snapshot(root, snapshot);
+    EXPECT_TRUE( snapshot.fresh(root) );
+
+    // An annex added, then a file added to it, then emptied.
+    boost::filesystem::create_directory(root / L"a b Un");
+    EXPECT_FALSE( snapshot.fresh(root) );
+    open_snapshot(root, snapshot);
+    EXPECT_TRUE( snapshot.fresh(root) );
+
+    dir.write(L"a b Un/f.txt", "f");
+    EXPECT_FALSE( snapshot.fresh(root) );
+    open_snapshot(root, snapshot);
+    EXPECT_TRUE( snapshot.fresh(root) );
+
+    boost::filesystem::remove(root / L"a b Un/f.txt");
+    EXPECT_FALSE( snapshot.fresh(root) );
+}
+
+TEST( plan_retag, rename_and_merge )
+{
+    TempDir dir;
+    path const & root = dir.path_of();
+
+    dir.write(L"a b Un.md",   "Sujet: Un\n\u00C9tiquettes: #x\n\n");
+    dir.write(L"x b Deux.md", "Sujet: Deux\n\n");
+    dir.write(L"y b Trois.md", "Sujet: Trois\n\u00C9tiquettes: #a\n\n");
+
+    Snapshot snapshot;
+    open_snapshot(root, snapshot, false);
+    EXPECT_FALSE( exists(root / L".notes_snapshot") );
+
+    // Renamed: only the name.
+    auto steps = plan_retag(root, snapshot, {L"#a"}, L"#c");
+    ASSERT_EQ( steps.size(), 2u );
+    EXPECT_EQ( steps[0].filename.filename(), path(L"a b Un.md") );
+    EXPECT_FALSE( steps[0].tags_field );
+    EXPECT_EQ( steps[0].renamed, root / L"c b Un.md" );
+    EXPECT_TRUE( steps[0].annex.empty() );
+    EXPECT_EQ( steps[1].filename.filename(), path(L"y b Trois.md") );
+    EXPECT_TRUE( steps[1].tags_field );
+    EXPECT_TRUE( steps[1].renamed.empty() );
+
+    // Merged: the name of one, the tags field of the other.
+    steps = plan_retag(root, snapshot, {L"#a", L"#x"}, L"#c");
+    ASSERT_EQ( steps.size(), 3u );
+    EXPECT_TRUE( steps[0].tags_field );
+    EXPECT_EQ( steps[0].renamed, root / L"c b Un.md" );
+    EXPECT_EQ( steps[1].renamed, root / L"c b Deux.md" );
+    EXPECT_TRUE( steps[2].tags_field );
+}
+
+TEST( plan_retag, taken_name )
+{
+    TempDir dir;
+    path const & root = dir.path_of();
+
+    dir.write(L"a b Un.md", "Sujet: Un\n\n");
+    dir.write(L"c b Un.md", "Sujet: Un\n\n");
+
+    Snapshot snapshot;
+    open_snapshot(root, snapshot, false);
+    EXPECT_THROW( plan_retag(root, snapshot, {L"#a"}, L"#c"), std::runtime_error );
+
+    // Two notes that would take the same name.
+    dir.write(L"d b Un.md", "Sujet: Un\n\n");
+    boost::filesystem::remove(root / L"c b Un.md");
+    open_snapshot(root, snapshot, false);
+    EXPECT_THROW( plan_retag(root, snapshot, {L"#a", L"#d"}, L"#c"), std::runtime_error );
+
+    // Once the name is free.
+    EXPECT_EQ( plan_retag(root, snapshot, {L"#a"}, L"#c").size(), 1u );
+}
+
+TEST( plan_retag, annex_after_snapshot )
+{
+    TempDir dir;
+    path const & root = dir.path_of();
+
+    dir.write(L"a b S.md", "Sujet: S\n\n");
+
+    Snapshot snapshot;
+    open_snapshot(root, snapshot, false);
+
+    boost::filesystem::create_directory(root / L"a b S");
+    dir.write(L"a b S/f.txt", "f");
+
+    auto steps = plan_retag(root, snapshot, {L"#a"}, L"#z");
+    ASSERT_EQ( steps.size(), 1u );
+    EXPECT_EQ( steps[0].annex, root / L"a b S" );
+    EXPECT_EQ( steps[0].renamed_annex, root / L"z b S" );
+}
+
+TEST( plan_retag, annex )
+{
+    TempDir dir;
+    path const & root = dir.path_of();
+
+    dir.write(L"a b Un.md", "Sujet: Un\n\u00C9tiquettes: #a\nStatut: ouvert\n\nCorps\n");
+    boost::filesystem::create_directory(root / L"a b Un");
+    dir.write(L"a b Un/f.txt", "f");
+
+    Snapshot snapshot;
+    open_snapshot(root, snapshot, false);
+
+    auto steps = plan_retag(root, snapshot, {L"#a"}, L"#c");
+    ASSERT_EQ( steps.size(), 1u );
+    EXPECT_EQ( steps[0].annex.filename(), path(L"a b Un") );
+    EXPECT_EQ( steps[0].renamed_annex, root / L"c b Un" );
+
+    apply_retag(steps[0], {L"#a"}, L"#c");
+    EXPECT_TRUE( exists(root / L"c b Un/f.txt") );
+    EXPECT_FALSE( exists(root / L"a b Un") );
+
+    // The fields keep their order.
+    EXPECT_EQ( dir.read(L"c b Un.md"), 
+        "Sujet: Un\n\u00C9tiquettes: #c\nStatut: ouvert\n\nCorps\n" );
+}
+
+TEST( CleanStore, markers )
+{
+    CleanStore store;
+    File file(L"./a b c.md");
+
+    store.mark(file, 42, 1000, 10, CleanStore::CHECKED, check_context(file, false));
+
+    EXPECT_TRUE( store.unchanged(file, 1000, 10, CleanStore::CHECKED) );
+    EXPECT_FALSE( store.unchanged(file, 1001, 10, CleanStore::CHECKED) );
+    EXPECT_FALSE( store.unchanged(file, 1000, 10, CleanStore::REPAIRED) );
+
+    EXPECT_TRUE( store.same_content(file, 42, CleanStore::CHECKED) );
+    EXPECT_FALSE( store.same_content(file, 43, CleanStore::CHECKED) );
+
+    // Same content, another annex: checked again.
+    File with_annex = file;
+    with_annex.annex = L"./a b c";
+    EXPECT_FALSE( store.same_content(with_annex, 42, CleanStore::CHECKED) );
+
+    store.mark(file, 42, 1000, 10, CleanStore::REPAIRED);
+    EXPECT_TRUE( store.unchanged(file, 1000, 10, CleanStore::CHECKED) );
+    EXPECT_TRUE( store.unchanged(file, 1000, 10, CleanStore::REPAIRED) );
+
+    // Another content: the markers of the previous one are gone.
+    store.mark(file, 7, 2000, 10, CleanStore::REPAIRED);
+    EXPECT_FALSE( store.unchanged(file, 2000, 10, CleanStore::CHECKED) );
+
+    store.unmark(file, CleanStore::REPAIRED);
+    EXPECT_FALSE( store.unchanged(file, 2000, 10, CleanStore::REPAIRED) );
+}
+
+int main(int argc, char ** argv)
+{
+    // UTF-8 whatever the environment: the tests hold UTF-8 names and
+    // notes.  Sets the C locale too, used by widen() and narrow().
+    std::locale utf8("C.UTF-8");
+    std::locale::global(utf8);
+    boost::filesystem::path::imbue(utf8);
+
     testing::InitGoogleTest(&argc, argv);
-      return RUN_ALL_TESTS();
+    return RUN_ALL_TESTS();
 }
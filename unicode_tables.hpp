@@ -0,0 +1,764 @@
+// Generated by make_unicode_tables from the Unicode 14.0.0 data.
+
+#ifndef UNICODE_TABLES_HPP
+#define UNICODE_TABLES_HPP
+
+// First, second, composite: sorted by composite.
+uint16_t const UNICODE_COMPOSITIONS[][3] = {
+    {0x0041,0x0300,0x00C0}, {0x0041,0x0301,0x00C1}, {0x0041,0x0302,0x00C2}, {0x0041,0x0303,0x00C3},
+    {0x0041,0x0308,0x00C4}, {0x0041,0x030A,0x00C5}, {0x0043,0x0327,0x00C7}, {0x0045,0x0300,0x00C8},
+    {0x0045,0x0301,0x00C9}, {0x0045,0x0302,0x00CA}, {0x0045,0x0308,0x00CB}, {0x0049,0x0300,0x00CC},
+    {0x0049,0x0301,0x00CD}, {0x0049,0x0302,0x00CE}, {0x0049,0x0308,0x00CF}, {0x004E,0x0303,0x00D1},
+    {0x004F,0x0300,0x00D2}, {0x004F,0x0301,0x00D3}, {0x004F,0x0302,0x00D4}, {0x004F,0x0303,0x00D5},
+    {0x004F,0x0308,0x00D6}, {0x0055,0x0300,0x00D9}, {0x0055,0x0301,0x00DA}, {0x0055,0x0302,0x00DB},
+    {0x0055,0x0308,0x00DC}, {0x0059,0x0301,0x00DD}, {0x0061,0x0300,0x00E0}, {0x0061,0x0301,0x00E1},
+    {0x0061,0x0302,0x00E2}, {0x0061,0x0303,0x00E3}, {0x0061,0x0308,0x00E4}, {0x0061,0x030A,0x00E5},
+    {0x0063,0x0327,0x00E7}, {0x0065,0x0300,0x00E8}, {0x0065,0x0301,0x00E9}, {0x0065,0x0302,0x00EA},
+    {0x0065,0x0308,0x00EB}, {0x0069,0x0300,0x00EC}, {0x0069,0x0301,0x00ED}, {0x0069,0x0302,0x00EE},
+    {0x0069,0x0308,0x00EF}, {0x006E,0x0303,0x00F1}, {0x006F,0x0300,0x00F2}, {0x006F,0x0301,0x00F3},
+    {0x006F,0x0302,0x00F4}, {0x006F,0x0303,0x00F5}, {0x006F,0x0308,0x00F6}, {0x0075,0x0300,0x00F9},
+    {0x0075,0x0301,0x00FA}, {0x0075,0x0302,0x00FB}, {0x0075,0x0308,0x00FC}, {0x0079,0x0301,0x00FD},
+    {0x0079,0x0308,0x00FF}, {0x0041,0x0304,0x0100}, {0x0061,0x0304,0x0101}, {0x0041,0x0306,0x0102},
+    {0x0061,0x0306,0x0103}, {0x0041,0x0328,0x0104}, {0x0061,0x0328,0x0105}, {0x0043,0x0301,0x0106},
+    {0x0063,0x0301,0x0107}, {0x0043,0x0302,0x0108}, {0x0063,0x0302,0x0109}, {0x0043,0x0307,0x010A},
+    {0x0063,0x0307,0x010B}, {0x0043,0x030C,0x010C}, {0x0063,0x030C,0x010D}, {0x0044,0x030C,0x010E},
+    {0x0064,0x030C,0x010F}, {0x0045,0x0304,0x0112}, {0x0065,0x0304,0x0113}, {0x0045,0x0306,0x0114},
+    {0x0065,0x0306,0x0115}, {0x0045,0x0307,0x0116}, {0x0065,0x0307,0x0117}, {0x0045,0x0328,0x0118},
+    {0x0065,0x0328,0x0119}, {0x0045,0x030C,0x011A}, {0x0065,0x030C,0x011B}, {0x0047,0x0302,0x011C},
+    {0x0067,0x0302,0x011D}, {0x0047,0x0306,0x011E}, {0x0067,0x0306,0x011F}, {0x0047,0x0307,0x0120},
+    {0x0067,0x0307,0x0121}, {0x0047,0x0327,0x0122}, {0x0067,0x0327,0x0123}, {0x0048,0x0302,0x0124},
+    {0x0068,0x0302,0x0125}, {0x0049,0x0303,0x0128}, {0x0069,0x0303,0x0129}, {0x0049,0x0304,0x012A},
+    {0x0069,0x0304,0x012B}, {0x0049,0x0306,0x012C}, {0x0069,0x0306,0x012D}, {0x0049,0x0328,0x012E},
+    {0x0069,0x0328,0x012F}, {0x0049,0x0307,0x0130}, {0x004A,0x0302,0x0134}, {0x006A,0x0302,0x0135},
+    {0x004B,0x0327,0x0136}, {0x006B,0x0327,0x0137}, {0x004C,0x0301,0x0139}, {0x006C,0x0301,0x013A},
+    {0x004C,0x0327,0x013B}, {0x006C,0x0327,0x013C}, {0x004C,0x030C,0x013D}, {0x006C,0x030C,0x013E},
+    {0x004E,0x0301,0x0143}, {0x006E,0x0301,0x0144}, {0x004E,0x0327,0x0145}, {0x006E,0x0327,0x0146},
+    {0x004E,0x030C,0x0147}, {0x006E,0x030C,0x0148}, {0x004F,0x0304,0x014C}, {0x006F,0x0304,0x014D},
+    {0x004F,0x0306,0x014E}, {0x006F,0x0306,0x014F}, {0x004F,0x030B,0x0150}, {0x006F,0x030B,0x0151},
+    {0x0052,0x0301,0x0154}, {0x0072,0x0301,0x0155}, {0x0052,0x0327,0x0156}, {0x0072,0x0327,0x0157},
+    {0x0052,0x030C,0x0158}, {0x0072,0x030C,0x0159}, {0x0053,0x0301,0x015A}, {0x0073,0x0301,0x015B},
+    {0x0053,0x0302,0x015C}, {0x0073,0x0302,0x015D}, {0x0053,0x0327,0x015E}, {0x0073,0x0327,0x015F},
+    {0x0053,0x030C,0x0160}, {0x0073,0x030C,0x0161}, {0x0054,0x0327,0x0162}, {0x0074,0x0327,0x0163},
+    {0x0054,0x030C,0x0164}, {0x0074,0x030C,0x0165}, {0x0055,0x0303,0x0168}, {0x0075,0x0303,0x0169},
+    {0x0055,0x0304,0x016A}, {0x0075,0x0304,0x016B}, {0x0055,0x0306,0x016C}, {0x0075,0x0306,0x016D},
+    {0x0055,0x030A,0x016E}, {0x0075,0x030A,0x016F}, {0x0055,0x030B,0x0170}, {0x0075,0x030B,0x0171},
+    {0x0055,0x0328,0x0172}, {0x0075,0x0328,0x0173}, {0x0057,0x0302,0x0174}, {0x0077,0x0302,0x0175},
+    {0x0059,0x0302,0x0176}, {0x0079,0x0302,0x0177}, {0x0059,0x0308,0x0178}, {0x005A,0x0301,0x0179},
+    {0x007A,0x0301,0x017A}, {0x005A,0x0307,0x017B}, {0x007A,0x0307,0x017C}, {0x005A,0x030C,0x017D},
+    {0x007A,0x030C,0x017E}, {0x004F,0x031B,0x01A0}, {0x006F,0x031B,0x01A1}, {0x0055,0x031B,0x01AF},
+    {0x0075,0x031B,0x01B0}, {0x0041,0x030C,0x01CD}, {0x0061,0x030C,0x01CE}, {0x0049,0x030C,0x01CF},
+    {0x0069,0x030C,0x01D0}, {0x004F,0x030C,0x01D1}, {0x006F,0x030C,0x01D2}, {0x0055,0x030C,0x01D3},
+    {0x0075,0x030C,0x01D4}, {0x00DC,0x0304,0x01D5}, {0x00FC,0x0304,0x01D6}, {0x00DC,0x0301,0x01D7},
+    {0x00FC,0x0301,0x01D8}, {0x00DC,0x030C,0x01D9}, {0x00FC,0x030C,0x01DA}, {0x00DC,0x0300,0x01DB},
+    {0x00FC,0x0300,0x01DC}, {0x00C4,0x0304,0x01DE}, {0x00E4,0x0304,0x01DF}, {0x0226,0x0304,0x01E0},
+    {0x0227,0x0304,0x01E1}, {0x00C6,0x0304,0x01E2}, {0x00E6,0x0304,0x01E3}, {0x0047,0x030C,0x01E6},
+    {0x0067,0x030C,0x01E7}, {0x004B,0x030C,0x01E8}, {0x006B,0x030C,0x01E9}, {0x004F,0x0328,0x01EA},
+    {0x006F,0x0328,0x01EB}, {0x01EA,0x0304,0x01EC}, {0x01EB,0x0304,0x01ED}, {0x01B7,0x030C,0x01EE},
+    {0x0292,0x030C,0x01EF}, {0x006A,0x030C,0x01F0}, {0x0047,0x0301,0x01F4}, {0x0067,0x0301,0x01F5},
+    {0x004E,0x0300,0x01F8}, {0x006E,0x0300,0x01F9}, {0x00C5,0x0301,0x01FA}, {0x00E5,0x0301,0x01FB},
+    {0x00C6,0x0301,0x01FC}, {0x00E6,0x0301,0x01FD}, {0x00D8,0x0301,0x01FE}, {0x00F8,0x0301,0x01FF},
+    {0x0041,0x030F,0x0200}, {0x0061,0x030F,0x0201}, {0x0041,0x0311,0x0202}, {0x0061,0x0311,0x0203},
+    {0x0045,0x030F,0x0204}, {0x0065,0x030F,0x0205}, {0x0045,0x0311,0x0206}, {0x0065,0x0311,0x0207},
+    {0x0049,0x030F,0x0208}, {0x0069,0x030F,0x0209}, {0x0049,0x0311,0x020A}, {0x0069,0x0311,0x020B},
+    {0x004F,0x030F,0x020C}, {0x006F,0x030F,0x020D}, {0x004F,0x0311,0x020E}, {0x006F,0x0311,0x020F},
+    {0x0052,0x030F,0x0210}, {0x0072,0x030F,0x0211}, {0x0052,0x0311,0x0212}, {0x0072,0x0311,0x0213},
+    {0x0055,0x030F,0x0214}, {0x0075,0x030F,0x0215}, {0x0055,0x0311,0x0216}, {0x0075,0x0311,0x0217},
+    {0x0053,0x0326,0x0218}, {0x0073,0x0326,0x0219}, {0x0054,0x0326,0x021A}, {0x0074,0x0326,0x021B},
+    {0x0048,0x030C,0x021E}, {0x0068,0x030C,0x021F}, {0x0041,0x0307,0x0226}, {0x0061,0x0307,0x0227},
+    {0x0045,0x0327,0x0228}, {0x0065,0x0327,0x0229}, {0x00D6,0x0304,0x022A}, {0x00F6,0x0304,0x022B},
+    {0x00D5,0x0304,0x022C}, {0x00F5,0x0304,0x022D}, {0x004F,0x0307,0x022E}, {0x006F,0x0307,0x022F},
+    {0x022E,0x0304,0x0230}, {0x022F,0x0304,0x0231}, {0x0059,0x0304,0x0232}, {0x0079,0x0304,0x0233},
+    {0x00A8,0x0301,0x0385}, {0x0391,0x0301,0x0386}, {0x0395,0x0301,0x0388}, {0x0397,0x0301,0x0389},
+    {0x0399,0x0301,0x038A}, {0x039F,0x0301,0x038C}, {0x03A5,0x0301,0x038E}, {0x03A9,0x0301,0x038F},
+    {0x03CA,0x0301,0x0390}, {0x0399,0x0308,0x03AA}, {0x03A5,0x0308,0x03AB}, {0x03B1,0x0301,0x03AC},
+    {0x03B5,0x0301,0x03AD}, {0x03B7,0x0301,0x03AE}, {0x03B9,0x0301,0x03AF}, {0x03CB,0x0301,0x03B0},
+    {0x03B9,0x0308,0x03CA}, {0x03C5,0x0308,0x03CB}, {0x03BF,0x0301,0x03CC}, {0x03C5,0x0301,0x03CD},
+    {0x03C9,0x0301,0x03CE}, {0x03D2,0x0301,0x03D3}, {0x03D2,0x0308,0x03D4}, {0x0415,0x0300,0x0400},
+    {0x0415,0x0308,0x0401}, {0x0413,0x0301,0x0403}, {0x0406,0x0308,0x0407}, {0x041A,0x0301,0x040C},
+    {0x0418,0x0300,0x040D}, {0x0423,0x0306,0x040E}, {0x0418,0x0306,0x0419}, {0x0438,0x0306,0x0439},
+    {0x0435,0x0300,0x0450}, {0x0435,0x0308,0x0451}, {0x0433,0x0301,0x0453}, {0x0456,0x0308,0x0457},
+    {0x043A,0x0301,0x045C}, {0x0438,0x0300,0x045D}, {0x0443,0x0306,0x045E}, {0x0474,0x030F,0x0476},
+    {0x0475,0x030F,0x0477}, {0x0416,0x0306,0x04C1}, {0x0436,0x0306,0x04C2}, {0x0410,0x0306,0x04D0},
+    {0x0430,0x0306,0x04D1}, {0x0410,0x0308,0x04D2}, {0x0430,0x0308,0x04D3}, {0x0415,0x0306,0x04D6},
+    {0x0435,0x0306,0x04D7}, {0x04D8,0x0308,0x04DA}, {0x04D9,0x0308,0x04DB}, {0x0416,0x0308,0x04DC},
+    {0x0436,0x0308,0x04DD}, {0x0417,0x0308,0x04DE}, {0x0437,0x0308,0x04DF}, {0x0418,0x0304,0x04E2},
+    {0x0438,0x0304,0x04E3}, {0x0418,0x0308,0x04E4}, {0x0438,0x0308,0x04E5}, {0x041E,0x0308,0x04E6},
+    {0x043E,0x0308,0x04E7}, {0x04E8,0x0308,0x04EA}, {0x04E9,0x0308,0x04EB}, {0x042D,0x0308,0x04EC},
+    {0x044D,0x0308,0x04ED}, {0x0423,0x0304,0x04EE}, {0x0443,0x0304,0x04EF}, {0x0423,0x0308,0x04F0},
+    {0x0443,0x0308,0x04F1}, {0x0423,0x030B,0x04F2}, {0x0443,0x030B,0x04F3}, {0x0427,0x0308,0x04F4},
+    {0x0447,0x0308,0x04F5}, {0x042B,0x0308,0x04F8}, {0x044B,0x0308,0x04F9}, {0x0627,0x0653,0x0622},
+    {0x0627,0x0654,0x0623}, {0x0648,0x0654,0x0624}, {0x0627,0x0655,0x0625}, {0x064A,0x0654,0x0626},
+    {0x06D5,0x0654,0x06C0}, {0x06C1,0x0654,0x06C2}, {0x06D2,0x0654,0x06D3}, {0x0928,0x093C,0x0929},
+    {0x0930,0x093C,0x0931}, {0x0933,0x093C,0x0934}, {0x09C7,0x09BE,0x09CB}, {0x09C7,0x09D7,0x09CC},
+    {0x0B47,0x0B56,0x0B48}, {0x0B47,0x0B3E,0x0B4B}, {0x0B47,0x0B57,0x0B4C}, {0x0B92,0x0BD7,0x0B94},
+    {0x0BC6,0x0BBE,0x0BCA}, {0x0BC7,0x0BBE,0x0BCB}, {0x0BC6,0x0BD7,0x0BCC}, {0x0C46,0x0C56,0x0C48},
+    {0x0CBF,0x0CD5,0x0CC0}, {0x0CC6,0x0CD5,0x0CC7}, {0x0CC6,0x0CD6,0x0CC8}, {0x0CC6,0x0CC2,0x0CCA},
+    {0x0CCA,0x0CD5,0x0CCB}, {0x0D46,0x0D3E,0x0D4A}, {0x0D47,0x0D3E,0x0D4B}, {0x0D46,0x0D57,0x0D4C},
+    {0x0DD9,0x0DCA,0x0DDA}, {0x0DD9,0x0DCF,0x0DDC}, {0x0DDC,0x0DCA,0x0DDD}, {0x0DD9,0x0DDF,0x0DDE},
+    {0x1025,0x102E,0x1026}, {0x1B05,0x1B35,0x1B06}, {0x1B07,0x1B35,0x1B08}, {0x1B09,0x1B35,0x1B0A},
+    {0x1B0B,0x1B35,0x1B0C}, {0x1B0D,0x1B35,0x1B0E}, {0x1B11,0x1B35,0x1B12}, {0x1B3A,0x1B35,0x1B3B},
+    {0x1B3C,0x1B35,0x1B3D}, {0x1B3E,0x1B35,0x1B40}, {0x1B3F,0x1B35,0x1B41}, {0x1B42,0x1B35,0x1B43},
+    {0x0041,0x0325,0x1E00}, {0x0061,0x0325,0x1E01}, {0x0042,0x0307,0x1E02}, {0x0062,0x0307,0x1E03},
+    {0x0042,0x0323,0x1E04}, {0x0062,0x0323,0x1E05}, {0x0042,0x0331,0x1E06}, {0x0062,0x0331,0x1E07},
+    {0x00C7,0x0301,0x1E08}, {0x00E7,0x0301,0x1E09}, {0x0044,0x0307,0x1E0A}, {0x0064,0x0307,0x1E0B},
+    {0x0044,0x0323,0x1E0C}, {0x0064,0x0323,0x1E0D}, {0x0044,0x0331,0x1E0E}, {0x0064,0x0331,0x1E0F},
+    {0x0044,0x0327,0x1E10}, {0x0064,0x0327,0x1E11}, {0x0044,0x032D,0x1E12}, {0x0064,0x032D,0x1E13},
+    {0x0112,0x0300,0x1E14}, {0x0113,0x0300,0x1E15}, {0x0112,0x0301,0x1E16}, {0x0113,0x0301,0x1E17},
+    {0x0045,0x032D,0x1E18}, {0x0065,0x032D,0x1E19}, {0x0045,0x0330,0x1E1A}, {0x0065,0x0330,0x1E1B},
+    {0x0228,0x0306,0x1E1C}, {0x0229,0x0306,0x1E1D}, {0x0046,0x0307,0x1E1E}, {0x0066,0x0307,0x1E1F},
+    {0x0047,0x0304,0x1E20}, {0x0067,0x0304,0x1E21}, {0x0048,0x0307,0x1E22}, {0x0068,0x0307,0x1E23},
+    {0x0048,0x0323,0x1E24}, {0x0068,0x0323,0x1E25}, {0x0048,0x0308,0x1E26}, {0x0068,0x0308,0x1E27},
+    {0x0048,0x0327,0x1E28}, {0x0068,0x0327,0x1E29}, {0x0048,0x032E,0x1E2A}, {0x0068,0x032E,0x1E2B},
+    {0x0049,0x0330,0x1E2C}, {0x0069,0x0330,0x1E2D}, {0x00CF,0x0301,0x1E2E}, {0x00EF,0x0301,0x1E2F},
+    {0x004B,0x0301,0x1E30}, {0x006B,0x0301,0x1E31}, {0x004B,0x0323,0x1E32}, {0x006B,0x0323,0x1E33},
+    {0x004B,0x0331,0x1E34}, {0x006B,0x0331,0x1E35}, {0x004C,0x0323,0x1E36}, {0x006C,0x0323,0x1E37},
+    {0x1E36,0x0304,0x1E38}, {0x1E37,0x0304,0x1E39}, {0x004C,0x0331,0x1E3A}, {0x006C,0x0331,0x1E3B},
+    {0x004C,0x032D,0x1E3C}, {0x006C,0x032D,0x1E3D}, {0x004D,0x0301,0x1E3E}, {0x006D,0x0301,0x1E3F},
+    {0x004D,0x0307,0x1E40}, {0x006D,0x0307,0x1E41}, {0x004D,0x0323,0x1E42}, {0x006D,0x0323,0x1E43},
+    {0x004E,0x0307,0x1E44}, {0x006E,0x0307,0x1E45}, {0x004E,0x0323,0x1E46}, {0x006E,0x0323,0x1E47},
+    {0x004E,0x0331,0x1E48}, {0x006E,0x0331,0x1E49}, {0x004E,0x032D,0x1E4A}, {0x006E,0x032D,0x1E4B},
+    {0x00D5,0x0301,0x1E4C}, {0x00F5,0x0301,0x1E4D}, {0x00D5,0x0308,0x1E4E}, {0x00F5,0x0308,0x1E4F},
+    {0x014C,0x0300,0x1E50}, {0x014D,0x0300,0x1E51}, {0x014C,0x0301,0x1E52}, {0x014D,0x0301,0x1E53},
+    {0x0050,0x0301,0x1E54}, {0x0070,0x0301,0x1E55}, {0x0050,0x0307,0x1E56}, {0x0070,0x0307,0x1E57},
+    {0x0052,0x0307,0x1E58}, {0x0072,0x0307,0x1E59}, {0x0052,0x0323,0x1E5A}, {0x0072,0x0323,0x1E5B},
+    {0x1E5A,0x0304,0x1E5C}, {0x1E5B,0x0304,0x1E5D}, {0x0052,0x0331,0x1E5E}, {0x0072,0x0331,0x1E5F},
+    {0x0053,0x0307,0x1E60}, {0x0073,0x0307,0x1E61}, {0x0053,0x0323,0x1E62}, {0x0073,0x0323,0x1E63},
+    {0x015A,0x0307,0x1E64}, {0x015B,0x0307,0x1E65}, {0x0160,0x0307,0x1E66}, {0x0161,0x0307,0x1E67},
+    {0x1E62,0x0307,0x1E68}, {0x1E63,0x0307,0x1E69}, {0x0054,0x0307,0x1E6A}, {0x0074,0x0307,0x1E6B},
+    {0x0054,0x0323,0x1E6C}, {0x0074,0x0323,0x1E6D}, {0x0054,0x0331,0x1E6E}, {0x0074,0x0331,0x1E6F},
+    {0x0054,0x032D,0x1E70}, {0x0074,0x032D,0x1E71}, {0x0055,0x0324,0x1E72}, {0x0075,0x0324,0x1E73},
+    {0x0055,0x0330,0x1E74}, {0x0075,0x0330,0x1E75}, {0x0055,0x032D,0x1E76}, {0x0075,0x032D,0x1E77},
+    {0x0168,0x0301,0x1E78}, {0x0169,0x0301,0x1E79}, {0x016A,0x0308,0x1E7A}, {0x016B,0x0308,0x1E7B},
+    {0x0056,0x0303,0x1E7C}, {0x0076,0x0303,0x1E7D}, {0x0056,0x0323,0x1E7E}, {0x0076,0x0323,0x1E7F},
+    {0x0057,0x0300,0x1E80}, {0x0077,0x0300,0x1E81}, {0x0057,0x0301,0x1E82}, {0x0077,0x0301,0x1E83},
+    {0x0057,0x0308,0x1E84}, {0x0077,0x0308,0x1E85}, {0x0057,0x0307,0x1E86}, {0x0077,0x0307,0x1E87},
+    {0x0057,0x0323,0x1E88}, {0x0077,0x0323,0x1E89}, {0x0058,0x0307,0x1E8A}, {0x0078,0x0307,0x1E8B},
+    {0x0058,0x0308,0x1E8C}, {0x0078,0x0308,0x1E8D}, {0x0059,0x0307,0x1E8E}, {0x0079,0x0307,0x1E8F},
+    {0x005A,0x0302,0x1E90}, {0x007A,0x0302,0x1E91}, {0x005A,0x0323,0x1E92}, {0x007A,0x0323,0x1E93},
+    {0x005A,0x0331,0x1E94}, {0x007A,0x0331,0x1E95}, {0x0068,0x0331,0x1E96}, {0x0074,0x0308,0x1E97},
+    {0x0077,0x030A,0x1E98}, {0x0079,0x030A,0x1E99}, {0x017F,0x0307,0x1E9B}, {0x0041,0x0323,0x1EA0},
+    {0x0061,0x0323,0x1EA1}, {0x0041,0x0309,0x1EA2}, {0x0061,0x0309,0x1EA3}, {0x00C2,0x0301,0x1EA4},
+    {0x00E2,0x0301,0x1EA5}, {0x00C2,0x0300,0x1EA6}, {0x00E2,0x0300,0x1EA7}, {0x00C2,0x0309,0x1EA8},
+    {0x00E2,0x0309,0x1EA9}, {0x00C2,0x0303,0x1EAA}, {0x00E2,0x0303,0x1EAB}, {0x1EA0,0x0302,0x1EAC},
+    {0x1EA1,0x0302,0x1EAD}, {0x0102,0x0301,0x1EAE}, {0x0103,0x0301,0x1EAF}, {0x0102,0x0300,0x1EB0},
+    {0x0103,0x0300,0x1EB1}, {0x0102,0x0309,0x1EB2}, {0x0103,0x0309,0x1EB3}, {0x0102,0x0303,0x1EB4},
+    {0x0103,0x0303,0x1EB5}, {0x1EA0,0x0306,0x1EB6}, {0x1EA1,0x0306,0x1EB7}, {0x0045,0x0323,0x1EB8},
+    {0x0065,0x0323,0x1EB9}, {0x0045,0x0309,0x1EBA}, {0x0065,0x0309,0x1EBB}, {0x0045,0x0303,0x1EBC},
+    {0x0065,0x0303,0x1EBD}, {0x00CA,0x0301,0x1EBE}, {0x00EA,0x0301,0x1EBF}, {0x00CA,0x0300,0x1EC0},
+    {0x00EA,0x0300,0x1EC1}, {0x00CA,0x0309,0x1EC2}, {0x00EA,0x0309,0x1EC3}, {0x00CA,0x0303,0x1EC4},
+    {0x00EA,0x0303,0x1EC5}, {0x1EB8,0x0302,0x1EC6}, {0x1EB9,0x0302,0x1EC7}, {0x0049,0x0309,0x1EC8},
+    {0x0069,0x0309,0x1EC9}, {0x0049,0x0323,0x1ECA}, {0x0069,0x0323,0x1ECB}, {0x004F,0x0323,0x1ECC},
+    {0x006F,0x0323,0x1ECD}, {0x004F,0x0309,0x1ECE}, {0x006F,0x0309,0x1ECF}, {0x00D4,0x0301,0x1ED0},
+    {0x00F4,0x0301,0x1ED1}, {0x00D4,0x0300,0x1ED2}, {0x00F4,0x0300,0x1ED3}, {0x00D4,0x0309,0x1ED4},
+    {0x00F4,0x0309,0x1ED5}, {0x00D4,0x0303,0x1ED6}, {0x00F4,0x0303,0x1ED7}, {0x1ECC,0x0302,0x1ED8},
+    {0x1ECD,0x0302,0x1ED9}, {0x01A0,0x0301,0x1EDA}, {0x01A1,0x0301,0x1EDB}, {0x01A0,0x0300,0x1EDC},
+    {0x01A1,0x0300,0x1EDD}, {0x01A0,0x0309,0x1EDE}, {0x01A1,0x0309,0x1EDF}, {0x01A0,0x0303,0x1EE0},
+    {0x01A1,0x0303,0x1EE1}, {0x01A0,0x0323,0x1EE2}, {0x01A1,0x0323,0x1EE3}, {0x0055,0x0323,0x1EE4},
+    {0x0075,0x0323,0x1EE5}, {0x0055,0x0309,0x1EE6}, {0x0075,0x0309,0x1EE7}, {0x01AF,0x0301,0x1EE8},
+    {0x01B0,0x0301,0x1EE9}, {0x01AF,0x0300,0x1EEA}, {0x01B0,0x0300,0x1EEB}, {0x01AF,0x0309,0x1EEC},
+    {0x01B0,0x0309,0x1EED}, {0x01AF,0x0303,0x1EEE}, {0x01B0,0x0303,0x1EEF}, {0x01AF,0x0323,0x1EF0},
+    {0x01B0,0x0323,0x1EF1}, {0x0059,0x0300,0x1EF2}, {0x0079,0x0300,0x1EF3}, {0x0059,0x0323,0x1EF4},
+    {0x0079,0x0323,0x1EF5}, {0x0059,0x0309,0x1EF6}, {0x0079,0x0309,0x1EF7}, {0x0059,0x0303,0x1EF8},
+    {0x0079,0x0303,0x1EF9}, {0x03B1,0x0313,0x1F00}, {0x03B1,0x0314,0x1F01}, {0x1F00,0x0300,0x1F02},
+    {0x1F01,0x0300,0x1F03}, {0x1F00,0x0301,0x1F04}, {0x1F01,0x0301,0x1F05}, {0x1F00,0x0342,0x1F06},
+    {0x1F01,0x0342,0x1F07}, {0x0391,0x0313,0x1F08}, {0x0391,0x0314,0x1F09}, {0x1F08,0x0300,0x1F0A},
+    {0x1F09,0x0300,0x1F0B}, {0x1F08,0x0301,0x1F0C}, {0x1F09,0x0301,0x1F0D}, {0x1F08,0x0342,0x1F0E},
+    {0x1F09,0x0342,0x1F0F}, {0x03B5,0x0313,0x1F10}, {0x03B5,0x0314,0x1F11}, {0x1F10,0x0300,0x1F12},
+    {0x1F11,0x0300,0x1F13}, {0x1F10,0x0301,0x1F14}, {0x1F11,0x0301,0x1F15}, {0x0395,0x0313,0x1F18},
+    {0x0395,0x0314,0x1F19}, {0x1F18,0x0300,0x1F1A}, {0x1F19,0x0300,0x1F1B}, {0x1F18,0x0301,0x1F1C},
+    {0x1F19,0x0301,0x1F1D}, {0x03B7,0x0313,0x1F20}, {0x03B7,0x0314,0x1F21}, {0x1F20,0x0300,0x1F22},
+    {0x1F21,0x0300,0x1F23}, {0x1F20,0x0301,0x1F24}, {0x1F21,0x0301,0x1F25}, {0x1F20,0x0342,0x1F26},
+    {0x1F21,0x0342,0x1F27}, {0x0397,0x0313,0x1F28}, {0x0397,0x0314,0x1F29}, {0x1F28,0x0300,0x1F2A},
+    {0x1F29,0x0300,0x1F2B}, {0x1F28,0x0301,0x1F2C}, {0x1F29,0x0301,0x1F2D}, {0x1F28,0x0342,0x1F2E},
+    {0x1F29,0x0342,0x1F2F}, {0x03B9,0x0313,0x1F30}, {0x03B9,0x0314,0x1F31}, {0x1F30,0x0300,0x1F32},
+    {0x1F31,0x0300,0x1F33}, {0x1F30,0x0301,0x1F34}, {0x1F31,0x0301,0x1F35}, {0x1F30,0x0342,0x1F36},
+    {0x1F31,0x0342,0x1F37}, {0x0399,0x0313,0x1F38}, {0x0399,0x0314,0x1F39}, {0x1F38,0x0300,0x1F3A},
+    {0x1F39,0x0300,0x1F3B}, {0x1F38,0x0301,0x1F3C}, {0x1F39,0x0301,0x1F3D}, {0x1F38,0x0342,0x1F3E},
+    {0x1F39,0x0342,0x1F3F}, {0x03BF,0x0313,0x1F40}, {0x03BF,0x0314,0x1F41}, {0x1F40,0x0300,0x1F42},
+    {0x1F41,0x0300,0x1F43}, {0x1F40,0x0301,0x1F44}, {0x1F41,0x0301,0x1F45}, {0x039F,0x0313,0x1F48},
+    {0x039F,0x0314,0x1F49}, {0x1F48,0x0300,0x1F4A}, {0x1F49,0x0300,0x1F4B}, {0x1F48,0x0301,0x1F4C},
+    {0x1F49,0x0301,0x1F4D}, {0x03C5,0x0313,0x1F50}, {0x03C5,0x0314,0x1F51}, {0x1F50,0x0300,0x1F52},
+    {0x1F51,0x0300,0x1F53}, {0x1F50,0x0301,0x1F54}, {0x1F51,0x0301,0x1F55}, {0x1F50,0x0342,0x1F56},
+    {0x1F51,0x0342,0x1F57}, {0x03A5,0x0314,0x1F59}, {0x1F59,0x0300,0x1F5B}, {0x1F59,0x0301,0x1F5D},
+    {0x1F59,0x0342,0x1F5F}, {0x03C9,0x0313,0x1F60}, {0x03C9,0x0314,0x1F61}, {0x1F60,0x0300,0x1F62},
+    {0x1F61,0x0300,0x1F63}, {0x1F60,0x0301,0x1F64}, {0x1F61,0x0301,0x1F65}, {0x1F60,0x0342,0x1F66},
+    {0x1F61,0x0342,0x1F67}, {0x03A9,0x0313,0x1F68}, {0x03A9,0x0314,0x1F69}, {0x1F68,0x0300,0x1F6A},
+    {0x1F69,0x0300,0x1F6B}, {0x1F68,0x0301,0x1F6C}, {0x1F69,0x0301,0x1F6D}, {0x1F68,0x0342,0x1F6E},
+    {0x1F69,0x0342,0x1F6F}, {0x03B1,0x0300,0x1F70}, {0x03B5,0x0300,0x1F72}, {0x03B7,0x0300,0x1F74},
+    {0x03B9,0x0300,0x1F76}, {0x03BF,0x0300,0x1F78}, {0x03C5,0x0300,0x1F7A}, {0x03C9,0x0300,0x1F7C},
+    {0x1F00,0x0345,0x1F80}, {0x1F01,0x0345,0x1F81}, {0x1F02,0x0345,0x1F82}, {0x1F03,0x0345,0x1F83},
+    {0x1F04,0x0345,0x1F84}, {0x1F05,0x0345,0x1F85}, {0x1F06,0x0345,0x1F86}, {0x1F07,0x0345,0x1F87},
+    {0x1F08,0x0345,0x1F88}, {0x1F09,0x0345,0x1F89}, {0x1F0A,0x0345,0x1F8A}, {0x1F0B,0x0345,0x1F8B},
+    {0x1F0C,0x0345,0x1F8C}, {0x1F0D,0x0345,0x1F8D}, {0x1F0E,0x0345,0x1F8E}, {0x1F0F,0x0345,0x1F8F},
+    {0x1F20,0x0345,0x1F90}, {0x1F21,0x0345,0x1F91}, {0x1F22,0x0345,0x1F92}, {0x1F23,0x0345,0x1F93},
+    {0x1F24,0x0345,0x1F94}, {0x1F25,0x0345,0x1F95}, {0x1F26,0x0345,0x1F96}, {0x1F27,0x0345,0x1F97},
+    {0x1F28,0x0345,0x1F98}, {0x1F29,0x0345,0x1F99}, {0x1F2A,0x0345,0x1F9A}, {0x1F2B,0x0345,0x1F9B},
+    {0x1F2C,0x0345,0x1F9C}, {0x1F2D,0x0345,0x1F9D}, {0x1F2E,0x0345,0x1F9E}, {0x1F2F,0x0345,0x1F9F},
+    {0x1F60,0x0345,0x1FA0}, {0x1F61,0x0345,0x1FA1}, {0x1F62,0x0345,0x1FA2}, {0x1F63,0x0345,0x1FA3},
+    {0x1F64,0x0345,0x1FA4}, {0x1F65,0x0345,0x1FA5}, {0x1F66,0x0345,0x1FA6}, {0x1F67,0x0345,0x1FA7},
+    {0x1F68,0x0345,0x1FA8}, {0x1F69,0x0345,0x1FA9}, {0x1F6A,0x0345,0x1FAA}, {0x1F6B,0x0345,0x1FAB},
+    {0x1F6C,0x0345,0x1FAC}, {0x1F6D,0x0345,0x1FAD}, {0x1F6E,0x0345,0x1FAE}, {0x1F6F,0x0345,0x1FAF},
+    {0x03B1,0x0306,0x1FB0}, {0x03B1,0x0304,0x1FB1}, {0x1F70,0x0345,0x1FB2}, {0x03B1,0x0345,0x1FB3},
+    {0x03AC,0x0345,0x1FB4}, {0x03B1,0x0342,0x1FB6}, {0x1FB6,0x0345,0x1FB7}, {0x0391,0x0306,0x1FB8},
+    {0x0391,0x0304,0x1FB9}, {0x0391,0x0300,0x1FBA}, {0x0391,0x0345,0x1FBC}, {0x00A8,0x0342,0x1FC1},
+    {0x1F74,0x0345,0x1FC2}, {0x03B7,0x0345,0x1FC3}, {0x03AE,0x0345,0x1FC4}, {0x03B7,0x0342,0x1FC6},
+    {0x1FC6,0x0345,0x1FC7}, {0x0395,0x0300,0x1FC8}, {0x0397,0x0300,0x1FCA}, {0x0397,0x0345,0x1FCC},
+    {0x1FBF,0x0300,0x1FCD}, {0x1FBF,0x0301,0x1FCE}, {0x1FBF,0x0342,0x1FCF}, {0x03B9,0x0306,0x1FD0},
+    {0x03B9,0x0304,0x1FD1}, {0x03CA,0x0300,0x1FD2}, {0x03B9,0x0342,0x1FD6}, {0x03CA,0x0342,0x1FD7},
+    {0x0399,0x0306,0x1FD8}, {0x0399,0x0304,0x1FD9}, {0x0399,0x0300,0x1FDA}, {0x1FFE,0x0300,0x1FDD},
+    {0x1FFE,0x0301,0x1FDE}, {0x1FFE,0x0342,0x1FDF}, {0x03C5,0x0306,0x1FE0}, {0x03C5,0x0304,0x1FE1},
+    {0x03CB,0x0300,0x1FE2}, {0x03C1,0x0313,0x1FE4}, {0x03C1,0x0314,0x1FE5}, {0x03C5,0x0342,0x1FE6},
+    {0x03CB,0x0342,0x1FE7}, {0x03A5,0x0306,0x1FE8}, {0x03A5,0x0304,0x1FE9}, {0x03A5,0x0300,0x1FEA},
+    {0x03A1,0x0314,0x1FEC}, {0x00A8,0x0300,0x1FED}, {0x1F7C,0x0345,0x1FF2}, {0x03C9,0x0345,0x1FF3},
+    {0x03CE,0x0345,0x1FF4}, {0x03C9,0x0342,0x1FF6}, {0x1FF6,0x0345,0x1FF7}, {0x039F,0x0300,0x1FF8},
+    {0x03A9,0x0300,0x1FFA}, {0x03A9,0x0345,0x1FFC}, {0x2190,0x0338,0x219A}, {0x2192,0x0338,0x219B},
+    {0x2194,0x0338,0x21AE}, {0x21D0,0x0338,0x21CD}, {0x21D4,0x0338,0x21CE}, {0x21D2,0x0338,0x21CF},
+    {0x2203,0x0338,0x2204}, {0x2208,0x0338,0x2209}, {0x220B,0x0338,0x220C}, {0x2223,0x0338,0x2224},
+    {0x2225,0x0338,0x2226}, {0x223C,0x0338,0x2241}, {0x2243,0x0338,0x2244}, {0x2245,0x0338,0x2247},
+    {0x2248,0x0338,0x2249}, {0x003D,0x0338,0x2260}, {0x2261,0x0338,0x2262}, {0x224D,0x0338,0x226D},
+    {0x003C,0x0338,0x226E}, {0x003E,0x0338,0x226F}, {0x2264,0x0338,0x2270}, {0x2265,0x0338,0x2271},
+    {0x2272,0x0338,0x2274}, {0x2273,0x0338,0x2275}, {0x2276,0x0338,0x2278}, {0x2277,0x0338,0x2279},
+    {0x227A,0x0338,0x2280}, {0x227B,0x0338,0x2281}, {0x2282,0x0338,0x2284}, {0x2283,0x0338,0x2285},
+    {0x2286,0x0338,0x2288}, {0x2287,0x0338,0x2289}, {0x22A2,0x0338,0x22AC}, {0x22A8,0x0338,0x22AD},
+    {0x22A9,0x0338,0x22AE}, {0x22AB,0x0338,0x22AF}, {0x227C,0x0338,0x22E0}, {0x227D,0x0338,0x22E1},
+    {0x2291,0x0338,0x22E2}, {0x2292,0x0338,0x22E3}, {0x22B2,0x0338,0x22EA}, {0x22B3,0x0338,0x22EB},
+    {0x22B4,0x0338,0x22EC}, {0x22B5,0x0338,0x22ED}, {0x304B,0x3099,0x304C}, {0x304D,0x3099,0x304E},
+    {0x304F,0x3099,0x3050}, {0x3051,0x3099,0x3052}, {0x3053,0x3099,0x3054}, {0x3055,0x3099,0x3056},
+    {0x3057,0x3099,0x3058}, {0x3059,0x3099,0x305A}, {0x305B,0x3099,0x305C}, {0x305D,0x3099,0x305E},
+    {0x305F,0x3099,0x3060}, {0x3061,0x3099,0x3062}, {0x3064,0x3099,0x3065}, {0x3066,0x3099,0x3067},
+    {0x3068,0x3099,0x3069}, {0x306F,0x3099,0x3070}, {0x306F,0x309A,0x3071}, {0x3072,0x3099,0x3073},
+    {0x3072,0x309A,0x3074}, {0x3075,0x3099,0x3076}, {0x3075,0x309A,0x3077}, {0x3078,0x3099,0x3079},
+    {0x3078,0x309A,0x307A}, {0x307B,0x3099,0x307C}, {0x307B,0x309A,0x307D}, {0x3046,0x3099,0x3094},
+    {0x309D,0x3099,0x309E}, {0x30AB,0x3099,0x30AC}, {0x30AD,0x3099,0x30AE}, {0x30AF,0x3099,0x30B0},
+    {0x30B1,0x3099,0x30B2}, {0x30B3,0x3099,0x30B4}, {0x30B5,0x3099,0x30B6}, {0x30B7,0x3099,0x30B8},
+    {0x30B9,0x3099,0x30BA}, {0x30BB,0x3099,0x30BC}, {0x30BD,0x3099,0x30BE}, {0x30BF,0x3099,0x30C0},
+    {0x30C1,0x3099,0x30C2}, {0x30C4,0x3099,0x30C5}, {0x30C6,0x3099,0x30C7}, {0x30C8,0x3099,0x30C9},
+    {0x30CF,0x3099,0x30D0}, {0x30CF,0x309A,0x30D1}, {0x30D2,0x3099,0x30D3}, {0x30D2,0x309A,0x30D4},
+    {0x30D5,0x3099,0x30D6}, {0x30D5,0x309A,0x30D7}, {0x30D8,0x3099,0x30D9}, {0x30D8,0x309A,0x30DA},
+    {0x30DB,0x3099,0x30DC}, {0x30DB,0x309A,0x30DD}, {0x30A6,0x3099,0x30F4}, {0x30EF,0x3099,0x30F7},
+    {0x30F0,0x3099,0x30F8}, {0x30F1,0x3099,0x30F9}, {0x30F2,0x3099,0x30FA}, {0x30FD,0x3099,0x30FE},
+};
+
+// Character, first, second (0 if none): sorted by character.
+uint32_t const UNICODE_DECOMPOSITIONS[][3] = {
+    {0x00C0,0x0041,0x0300}, {0x00C1,0x0041,0x0301}, {0x00C2,0x0041,0x0302}, {0x00C3,0x0041,0x0303},
+    {0x00C4,0x0041,0x0308}, {0x00C5,0x0041,0x030A}, {0x00C7,0x0043,0x0327}, {0x00C8,0x0045,0x0300},
+    {0x00C9,0x0045,0x0301}, {0x00CA,0x0045,0x0302}, {0x00CB,0x0045,0x0308}, {0x00CC,0x0049,0x0300},
+    {0x00CD,0x0049,0x0301}, {0x00CE,0x0049,0x0302}, {0x00CF,0x0049,0x0308}, {0x00D1,0x004E,0x0303},
+    {0x00D2,0x004F,0x0300}, {0x00D3,0x004F,0x0301}, {0x00D4,0x004F,0x0302}, {0x00D5,0x004F,0x0303},
+    {0x00D6,0x004F,0x0308}, {0x00D9,0x0055,0x0300}, {0x00DA,0x0055,0x0301}, {0x00DB,0x0055,0x0302},
+    {0x00DC,0x0055,0x0308}, {0x00DD,0x0059,0x0301}, {0x00E0,0x0061,0x0300}, {0x00E1,0x0061,0x0301},
+    {0x00E2,0x0061,0x0302}, {0x00E3,0x0061,0x0303}, {0x00E4,0x0061,0x0308}, {0x00E5,0x0061,0x030A},
+    {0x00E7,0x0063,0x0327}, {0x00E8,0x0065,0x0300}, {0x00E9,0x0065,0x0301}, {0x00EA,0x0065,0x0302},
+    {0x00EB,0x0065,0x0308}, {0x00EC,0x0069,0x0300}, {0x00ED,0x0069,0x0301}, {0x00EE,0x0069,0x0302},
+    {0x00EF,0x0069,0x0308}, {0x00F1,0x006E,0x0303}, {0x00F2,0x006F,0x0300}, {0x00F3,0x006F,0x0301},
+    {0x00F4,0x006F,0x0302}, {0x00F5,0x006F,0x0303}, {0x00F6,0x006F,0x0308}, {0x00F9,0x0075,0x0300},
+    {0x00FA,0x0075,0x0301}, {0x00FB,0x0075,0x0302}, {0x00FC,0x0075,0x0308}, {0x00FD,0x0079,0x0301},
+    {0x00FF,0x0079,0x0308}, {0x0100,0x0041,0x0304}, {0x0101,0x0061,0x0304}, {0x0102,0x0041,0x0306},
+    {0x0103,0x0061,0x0306}, {0x0104,0x0041,0x0328}, {0x0105,0x0061,0x0328}, {0x0106,0x0043,0x0301},
+    {0x0107,0x0063,0x0301}, {0x0108,0x0043,0x0302}, {0x0109,0x0063,0x0302}, {0x010A,0x0043,0x0307},
+    {0x010B,0x0063,0x0307}, {0x010C,0x0043,0x030C}, {0x010D,0x0063,0x030C}, {0x010E,0x0044,0x030C},
+    {0x010F,0x0064,0x030C}, {0x0112,0x0045,0x0304}, {0x0113,0x0065,0x0304}, {0x0114,0x0045,0x0306},
+    {0x0115,0x0065,0x0306}, {0x0116,0x0045,0x0307}, {0x0117,0x0065,0x0307}, {0x0118,0x0045,0x0328},
+    {0x0119,0x0065,0x0328}, {0x011A,0x0045,0x030C}, {0x011B,0x0065,0x030C}, {0x011C,0x0047,0x0302},
+    {0x011D,0x0067,0x0302}, {0x011E,0x0047,0x0306}, {0x011F,0x0067,0x0306}, {0x0120,0x0047,0x0307},
+    {0x0121,0x0067,0x0307}, {0x0122,0x0047,0x0327}, {0x0123,0x0067,0x0327}, {0x0124,0x0048,0x0302},
+    {0x0125,0x0068,0x0302}, {0x0128,0x0049,0x0303}, {0x0129,0x0069,0x0303}, {0x012A,0x0049,0x0304},
+    {0x012B,0x0069,0x0304}, {0x012C,0x0049,0x0306}, {0x012D,0x0069,0x0306}, {0x012E,0x0049,0x0328},
+    {0x012F,0x0069,0x0328}, {0x0130,0x0049,0x0307}, {0x0134,0x004A,0x0302}, {0x0135,0x006A,0x0302},
+    {0x0136,0x004B,0x0327}, {0x0137,0x006B,0x0327}, {0x0139,0x004C,0x0301}, {0x013A,0x006C,0x0301},
+    {0x013B,0x004C,0x0327}, {0x013C,0x006C,0x0327}, {0x013D,0x004C,0x030C}, {0x013E,0x006C,0x030C},
+    {0x0143,0x004E,0x0301}, {0x0144,0x006E,0x0301}, {0x0145,0x004E,0x0327}, {0x0146,0x006E,0x0327},
+    {0x0147,0x004E,0x030C}, {0x0148,0x006E,0x030C}, {0x014C,0x004F,0x0304}, {0x014D,0x006F,0x0304},
+    {0x014E,0x004F,0x0306}, {0x014F,0x006F,0x0306}, {0x0150,0x004F,0x030B}, {0x0151,0x006F,0x030B},
+    {0x0154,0x0052,0x0301}, {0x0155,0x0072,0x0301}, {0x0156,0x0052,0x0327}, {0x0157,0x0072,0x0327},
+    {0x0158,0x0052,0x030C}, {0x0159,0x0072,0x030C}, {0x015A,0x0053,0x0301}, {0x015B,0x0073,0x0301},
+    {0x015C,0x0053,0x0302}, {0x015D,0x0073,0x0302}, {0x015E,0x0053,0x0327}, {0x015F,0x0073,0x0327},
+    {0x0160,0x0053,0x030C}, {0x0161,0x0073,0x030C}, {0x0162,0x0054,0x0327}, {0x0163,0x0074,0x0327},
+    {0x0164,0x0054,0x030C}, {0x0165,0x0074,0x030C}, {0x0168,0x0055,0x0303}, {0x0169,0x0075,0x0303},
+    {0x016A,0x0055,0x0304}, {0x016B,0x0075,0x0304}, {0x016C,0x0055,0x0306}, {0x016D,0x0075,0x0306},
+    {0x016E,0x0055,0x030A}, {0x016F,0x0075,0x030A}, {0x0170,0x0055,0x030B}, {0x0171,0x0075,0x030B},
+    {0x0172,0x0055,0x0328}, {0x0173,0x0075,0x0328}, {0x0174,0x0057,0x0302}, {0x0175,0x0077,0x0302},
+    {0x0176,0x0059,0x0302}, {0x0177,0x0079,0x0302}, {0x0178,0x0059,0x0308}, {0x0179,0x005A,0x0301},
+    {0x017A,0x007A,0x0301}, {0x017B,0x005A,0x0307}, {0x017C,0x007A,0x0307}, {0x017D,0x005A,0x030C},
+    {0x017E,0x007A,0x030C}, {0x01A0,0x004F,0x031B}, {0x01A1,0x006F,0x031B}, {0x01AF,0x0055,0x031B},
+    {0x01B0,0x0075,0x031B}, {0x01CD,0x0041,0x030C}, {0x01CE,0x0061,0x030C}, {0x01CF,0x0049,0x030C},
+    {0x01D0,0x0069,0x030C}, {0x01D1,0x004F,0x030C}, {0x01D2,0x006F,0x030C}, {0x01D3,0x0055,0x030C},
+    {0x01D4,0x0075,0x030C}, {0x01D5,0x00DC,0x0304}, {0x01D6,0x00FC,0x0304}, {0x01D7,0x00DC,0x0301},
+    {0x01D8,0x00FC,0x0301}, {0x01D9,0x00DC,0x030C}, {0x01DA,0x00FC,0x030C}, {0x01DB,0x00DC,0x0300},
+    {0x01DC,0x00FC,0x0300}, {0x01DE,0x00C4,0x0304}, {0x01DF,0x00E4,0x0304}, {0x01E0,0x0226,0x0304},
+    {0x01E1,0x0227,0x0304}, {0x01E2,0x00C6,0x0304}, {0x01E3,0x00E6,0x0304}, {0x01E6,0x0047,0x030C},
+    {0x01E7,0x0067,0x030C}, {0x01E8,0x004B,0x030C}, {0x01E9,0x006B,0x030C}, {0x01EA,0x004F,0x0328},
+    {0x01EB,0x006F,0x0328}, {0x01EC,0x01EA,0x0304}, {0x01ED,0x01EB,0x0304}, {0x01EE,0x01B7,0x030C},
+    {0x01EF,0x0292,0x030C}, {0x01F0,0x006A,0x030C}, {0x01F4,0x0047,0x0301}, {0x01F5,0x0067,0x0301},
+    {0x01F8,0x004E,0x0300}, {0x01F9,0x006E,0x0300}, {0x01FA,0x00C5,0x0301}, {0x01FB,0x00E5,0x0301},
+    {0x01FC,0x00C6,0x0301}, {0x01FD,0x00E6,0x0301}, {0x01FE,0x00D8,0x0301}, {0x01FF,0x00F8,0x0301},
+    {0x0200,0x0041,0x030F}, {0x0201,0x0061,0x030F}, {0x0202,0x0041,0x0311}, {0x0203,0x0061,0x0311},
+    {0x0204,0x0045,0x030F}, {0x0205,0x0065,0x030F}, {0x0206,0x0045,0x0311}, {0x0207,0x0065,0x0311},
+    {0x0208,0x0049,0x030F}, {0x0209,0x0069,0x030F}, {0x020A,0x0049,0x0311}, {0x020B,0x0069,0x0311},
+    {0x020C,0x004F,0x030F}, {0x020D,0x006F,0x030F}, {0x020E,0x004F,0x0311}, {0x020F,0x006F,0x0311},
+    {0x0210,0x0052,0x030F}, {0x0211,0x0072,0x030F}, {0x0212,0x0052,0x0311}, {0x0213,0x0072,0x0311},
+    {0x0214,0x0055,0x030F}, {0x0215,0x0075,0x030F}, {0x0216,0x0055,0x0311}, {0x0217,0x0075,0x0311},
+    {0x0218,0x0053,0x0326}, {0x0219,0x0073,0x0326}, {0x021A,0x0054,0x0326}, {0x021B,0x0074,0x0326},
+    {0x021E,0x0048,0x030C}, {0x021F,0x0068,0x030C}, {0x0226,0x0041,0x0307}, {0x0227,0x0061,0x0307},
+    {0x0228,0x0045,0x0327}, {0x0229,0x0065,0x0327}, {0x022A,0x00D6,0x0304}, {0x022B,0x00F6,0x0304},
+    {0x022C,0x00D5,0x0304}, {0x022D,0x00F5,0x0304}, {0x022E,0x004F,0x0307}, {0x022F,0x006F,0x0307},
+    {0x0230,0x022E,0x0304}, {0x0231,0x022F,0x0304}, {0x0232,0x0059,0x0304}, {0x0233,0x0079,0x0304},
+    {0x0340,0x0300,0x0000}, {0x0341,0x0301,0x0000}, {0x0343,0x0313,0x0000}, {0x0344,0x0308,0x0301},
+    {0x0374,0x02B9,0x0000}, {0x037E,0x003B,0x0000}, {0x0385,0x00A8,0x0301}, {0x0386,0x0391,0x0301},
+    {0x0387,0x00B7,0x0000}, {0x0388,0x0395,0x0301}, {0x0389,0x0397,0x0301}, {0x038A,0x0399,0x0301},
+    {0x038C,0x039F,0x0301}, {0x038E,0x03A5,0x0301}, {0x038F,0x03A9,0x0301}, {0x0390,0x03CA,0x0301},
+    {0x03AA,0x0399,0x0308}, {0x03AB,0x03A5,0x0308}, {0x03AC,0x03B1,0x0301}, {0x03AD,0x03B5,0x0301},
+    {0x03AE,0x03B7,0x0301}, {0x03AF,0x03B9,0x0301}, {0x03B0,0x03CB,0x0301}, {0x03CA,0x03B9,0x0308},
+    {0x03CB,0x03C5,0x0308}, {0x03CC,0x03BF,0x0301}, {0x03CD,0x03C5,0x0301}, {0x03CE,0x03C9,0x0301},
+    {0x03D3,0x03D2,0x0301}, {0x03D4,0x03D2,0x0308}, {0x0400,0x0415,0x0300}, {0x0401,0x0415,0x0308},
+    {0x0403,0x0413,0x0301}, {0x0407,0x0406,0x0308}, {0x040C,0x041A,0x0301}, {0x040D,0x0418,0x0300},
+    {0x040E,0x0423,0x0306}, {0x0419,0x0418,0x0306}, {0x0439,0x0438,0x0306}, {0x0450,0x0435,0x0300},
+    {0x0451,0x0435,0x0308}, {0x0453,0x0433,0x0301}, {0x0457,0x0456,0x0308}, {0x045C,0x043A,0x0301},
+    {0x045D,0x0438,0x0300}, {0x045E,0x0443,0x0306}, {0x0476,0x0474,0x030F}, {0x0477,0x0475,0x030F},
+    {0x04C1,0x0416,0x0306}, {0x04C2,0x0436,0x0306}, {0x04D0,0x0410,0x0306}, {0x04D1,0x0430,0x0306},
+    {0x04D2,0x0410,0x0308}, {0x04D3,0x0430,0x0308}, {0x04D6,0x0415,0x0306}, {0x04D7,0x0435,0x0306},
+    {0x04DA,0x04D8,0x0308}, {0x04DB,0x04D9,0x0308}, {0x04DC,0x0416,0x0308}, {0x04DD,0x0436,0x0308},
+    {0x04DE,0x0417,0x0308}, {0x04DF,0x0437,0x0308}, {0x04E2,0x0418,0x0304}, {0x04E3,0x0438,0x0304},
+    {0x04E4,0x0418,0x0308}, {0x04E5,0x0438,0x0308}, {0x04E6,0x041E,0x0308}, {0x04E7,0x043E,0x0308},
+    {0x04EA,0x04E8,0x0308}, {0x04EB,0x04E9,0x0308}, {0x04EC,0x042D,0x0308}, {0x04ED,0x044D,0x0308},
+    {0x04EE,0x0423,0x0304}, {0x04EF,0x0443,0x0304}, {0x04F0,0x0423,0x0308}, {0x04F1,0x0443,0x0308},
+    {0x04F2,0x0423,0x030B}, {0x04F3,0x0443,0x030B}, {0x04F4,0x0427,0x0308}, {0x04F5,0x0447,0x0308},
+    {0x04F8,0x042B,0x0308}, {0x04F9,0x044B,0x0308}, {0x0622,0x0627,0x0653}, {0x0623,0x0627,0x0654},
+    {0x0624,0x0648,0x0654}, {0x0625,0x0627,0x0655}, {0x0626,0x064A,0x0654}, {0x06C0,0x06D5,0x0654},
+    {0x06C2,0x06C1,0x0654}, {0x06D3,0x06D2,0x0654}, {0x0929,0x0928,0x093C}, {0x0931,0x0930,0x093C},
+    {0x0934,0x0933,0x093C}, {0x0958,0x0915,0x093C}, {0x0959,0x0916,0x093C}, {0x095A,0x0917,0x093C},
+    {0x095B,0x091C,0x093C}, {0x095C,0x0921,0x093C}, {0x095D,0x0922,0x093C}, {0x095E,0x092B,0x093C},
+    {0x095F,0x092F,0x093C}, {0x09CB,0x09C7,0x09BE}, {0x09CC,0x09C7,0x09D7}, {0x09DC,0x09A1,0x09BC},
+    {0x09DD,0x09A2,0x09BC}, {0x09DF,0x09AF,0x09BC}, {0x0A33,0x0A32,0x0A3C}, {0x0A36,0x0A38,0x0A3C},
+    {0x0A59,0x0A16,0x0A3C}, {0x0A5A,0x0A17,0x0A3C}, {0x0A5B,0x0A1C,0x0A3C}, {0x0A5E,0x0A2B,0x0A3C},
+    {0x0B48,0x0B47,0x0B56}, {0x0B4B,0x0B47,0x0B3E}, {0x0B4C,0x0B47,0x0B57}, {0x0B5C,0x0B21,0x0B3C},
+    {0x0B5D,0x0B22,0x0B3C}, {0x0B94,0x0B92,0x0BD7}, {0x0BCA,0x0BC6,0x0BBE}, {0x0BCB,0x0BC7,0x0BBE},
+    {0x0BCC,0x0BC6,0x0BD7}, {0x0C48,0x0C46,0x0C56}, {0x0CC0,0x0CBF,0x0CD5}, {0x0CC7,0x0CC6,0x0CD5},
+    {0x0CC8,0x0CC6,0x0CD6}, {0x0CCA,0x0CC6,0x0CC2}, {0x0CCB,0x0CCA,0x0CD5}, {0x0D4A,0x0D46,0x0D3E},
+    {0x0D4B,0x0D47,0x0D3E}, {0x0D4C,0x0D46,0x0D57}, {0x0DDA,0x0DD9,0x0DCA}, {0x0DDC,0x0DD9,0x0DCF},
+    {0x0DDD,0x0DDC,0x0DCA}, {0x0DDE,0x0DD9,0x0DDF}, {0x0F43,0x0F42,0x0FB7}, {0x0F4D,0x0F4C,0x0FB7},
+    {0x0F52,0x0F51,0x0FB7}, {0x0F57,0x0F56,0x0FB7}, {0x0F5C,0x0F5B,0x0FB7}, {0x0F69,0x0F40,0x0FB5},
+    {0x0F73,0x0F71,0x0F72}, {0x0F75,0x0F71,0x0F74}, {0x0F76,0x0FB2,0x0F80}, {0x0F78,0x0FB3,0x0F80},
+    {0x0F81,0x0F71,0x0F80}, {0x0F93,0x0F92,0x0FB7}, {0x0F9D,0x0F9C,0x0FB7}, {0x0FA2,0x0FA1,0x0FB7},
+    {0x0FA7,0x0FA6,0x0FB7}, {0x0FAC,0x0FAB,0x0FB7}, {0x0FB9,0x0F90,0x0FB5}, {0x1026,0x1025,0x102E},
+    {0x1B06,0x1B05,0x1B35}, {0x1B08,0x1B07,0x1B35}, {0x1B0A,0x1B09,0x1B35}, {0x1B0C,0x1B0B,0x1B35},
+    {0x1B0E,0x1B0D,0x1B35}, {0x1B12,0x1B11,0x1B35}, {0x1B3B,0x1B3A,0x1B35}, {0x1B3D,0x1B3C,0x1B35},
+    {0x1B40,0x1B3E,0x1B35}, {0x1B41,0x1B3F,0x1B35}, {0x1B43,0x1B42,0x1B35}, {0x1E00,0x0041,0x0325},
+    {0x1E01,0x0061,0x0325}, {0x1E02,0x0042,0x0307}, {0x1E03,0x0062,0x0307}, {0x1E04,0x0042,0x0323},
+    {0x1E05,0x0062,0x0323}, {0x1E06,0x0042,0x0331}, {0x1E07,0x0062,0x0331}, {0x1E08,0x00C7,0x0301},
+    {0x1E09,0x00E7,0x0301}, {0x1E0A,0x0044,0x0307}, {0x1E0B,0x0064,0x0307}, {0x1E0C,0x0044,0x0323},
+    {0x1E0D,0x0064,0x0323}, {0x1E0E,0x0044,0x0331}, {0x1E0F,0x0064,0x0331}, {0x1E10,0x0044,0x0327},
+    {0x1E11,0x0064,0x0327}, {0x1E12,0x0044,0x032D}, {0x1E13,0x0064,0x032D}, {0x1E14,0x0112,0x0300},
+    {0x1E15,0x0113,0x0300}, {0x1E16,0x0112,0x0301}, {0x1E17,0x0113,0x0301}, {0x1E18,0x0045,0x032D},
+    {0x1E19,0x0065,0x032D}, {0x1E1A,0x0045,0x0330}, {0x1E1B,0x0065,0x0330}, {0x1E1C,0x0228,0x0306},
+    {0x1E1D,0x0229,0x0306}, {0x1E1E,0x0046,0x0307}, {0x1E1F,0x0066,0x0307}, {0x1E20,0x0047,0x0304},
+    {0x1E21,0x0067,0x0304}, {0x1E22,0x0048,0x0307}, {0x1E23,0x0068,0x0307}, {0x1E24,0x0048,0x0323},
+    {0x1E25,0x0068,0x0323}, {0x1E26,0x0048,0x0308}, {0x1E27,0x0068,0x0308}, {0x1E28,0x0048,0x0327},
+    {0x1E29,0x0068,0x0327}, {0x1E2A,0x0048,0x032E}, {0x1E2B,0x0068,0x032E}, {0x1E2C,0x0049,0x0330},
+    {0x1E2D,0x0069,0x0330}, {0x1E2E,0x00CF,0x0301}, {0x1E2F,0x00EF,0x0301}, {0x1E30,0x004B,0x0301},
+    {0x1E31,0x006B,0x0301}, {0x1E32,0x004B,0x0323}, {0x1E33,0x006B,0x0323}, {0x1E34,0x004B,0x0331},
+    {0x1E35,0x006B,0x0331}, {0x1E36,0x004C,0x0323}, {0x1E37,0x006C,0x0323}, {0x1E38,0x1E36,0x0304},
+    {0x1E39,0x1E37,0x0304}, {0x1E3A,0x004C,0x0331}, {0x1E3B,0x006C,0x0331}, {0x1E3C,0x004C,0x032D},
+    {0x1E3D,0x006C,0x032D}, {0x1E3E,0x004D,0x0301}, {0x1E3F,0x006D,0x0301}, {0x1E40,0x004D,0x0307},
+    {0x1E41,0x006D,0x0307}, {0x1E42,0x004D,0x0323}, {0x1E43,0x006D,0x0323}, {0x1E44,0x004E,0x0307},
+    {0x1E45,0x006E,0x0307}, {0x1E46,0x004E,0x0323}, {0x1E47,0x006E,0x0323}, {0x1E48,0x004E,0x0331},
+    {0x1E49,0x006E,0x0331}, {0x1E4A,0x004E,0x032D}, {0x1E4B,0x006E,0x032D}, {0x1E4C,0x00D5,0x0301},
+    {0x1E4D,0x00F5,0x0301}, {0x1E4E,0x00D5,0x0308}, {0x1E4F,0x00F5,0x0308}, {0x1E50,0x014C,0x0300},
+    {0x1E51,0x014D,0x0300}, {0x1E52,0x014C,0x0301}, {0x1E53,0x014D,0x0301}, {0x1E54,0x0050,0x0301},
+    {0x1E55,0x0070,0x0301}, {0x1E56,0x0050,0x0307}, {0x1E57,0x0070,0x0307}, {0x1E58,0x0052,0x0307},
+    {0x1E59,0x0072,0x0307}, {0x1E5A,0x0052,0x0323}, {0x1E5B,0x0072,0x0323}, {0x1E5C,0x1E5A,0x0304},
+    {0x1E5D,0x1E5B,0x0304}, {0x1E5E,0x0052,0x0331}, {0x1E5F,0x0072,0x0331}, {0x1E60,0x0053,0x0307},
+    {0x1E61,0x0073,0x0307}, {0x1E62,0x0053,0x0323}, {0x1E63,0x0073,0x0323}, {0x1E64,0x015A,0x0307},
+    {0x1E65,0x015B,0x0307}, {0x1E66,0x0160,0x0307}, {0x1E67,0x0161,0x0307}, {0x1E68,0x1E62,0x0307},
+    {0x1E69,0x1E63,0x0307}, {0x1E6A,0x0054,0x0307}, {0x1E6B,0x0074,0x0307}, {0x1E6C,0x0054,0x0323},
+    {0x1E6D,0x0074,0x0323}, {0x1E6E,0x0054,0x0331}, {0x1E6F,0x0074,0x0331}, {0x1E70,0x0054,0x032D},
+    {0x1E71,0x0074,0x032D}, {0x1E72,0x0055,0x0324}, {0x1E73,0x0075,0x0324}, {0x1E74,0x0055,0x0330},
+    {0x1E75,0x0075,0x0330}, {0x1E76,0x0055,0x032D}, {0x1E77,0x0075,0x032D}, {0x1E78,0x0168,0x0301},
+    {0x1E79,0x0169,0x0301}, {0x1E7A,0x016A,0x0308}, {0x1E7B,0x016B,0x0308}, {0x1E7C,0x0056,0x0303},
+    {0x1E7D,0x0076,0x0303}, {0x1E7E,0x0056,0x0323}, {0x1E7F,0x0076,0x0323}, {0x1E80,0x0057,0x0300},
+    {0x1E81,0x0077,0x0300}, {0x1E82,0x0057,0x0301}, {0x1E83,0x0077,0x0301}, {0x1E84,0x0057,0x0308},
+    {0x1E85,0x0077,0x0308}, {0x1E86,0x0057,0x0307}, {0x1E87,0x0077,0x0307}, {0x1E88,0x0057,0x0323},
+    {0x1E89,0x0077,0x0323}, {0x1E8A,0x0058,0x0307}, {0x1E8B,0x0078,0x0307}, {0x1E8C,0x0058,0x0308},
+    {0x1E8D,0x0078,0x0308}, {0x1E8E,0x0059,0x0307}, {0x1E8F,0x0079,0x0307}, {0x1E90,0x005A,0x0302},
+    {0x1E91,0x007A,0x0302}, {0x1E92,0x005A,0x0323}, {0x1E93,0x007A,0x0323}, {0x1E94,0x005A,0x0331},
+    {0x1E95,0x007A,0x0331}, {0x1E96,0x0068,0x0331}, {0x1E97,0x0074,0x0308}, {0x1E98,0x0077,0x030A},
+    {0x1E99,0x0079,0x030A}, {0x1E9B,0x017F,0x0307}, {0x1EA0,0x0041,0x0323}, {0x1EA1,0x0061,0x0323},
+    {0x1EA2,0x0041,0x0309}, {0x1EA3,0x0061,0x0309}, {0x1EA4,0x00C2,0x0301}, {0x1EA5,0x00E2,0x0301},
+    {0x1EA6,0x00C2,0x0300}, {0x1EA7,0x00E2,0x0300}, {0x1EA8,0x00C2,0x0309}, {0x1EA9,0x00E2,0x0309},
+    {0x1EAA,0x00C2,0x0303}, {0x1EAB,0x00E2,0x0303}, {0x1EAC,0x1EA0,0x0302}, {0x1EAD,0x1EA1,0x0302},
+    {0x1EAE,0x0102,0x0301}, {0x1EAF,0x0103,0x0301}, {0x1EB0,0x0102,0x0300}, {0x1EB1,0x0103,0x0300},
+    {0x1EB2,0x0102,0x0309}, {0x1EB3,0x0103,0x0309}, {0x1EB4,0x0102,0x0303}, {0x1EB5,0x0103,0x0303},
+    {0x1EB6,0x1EA0,0x0306}, {0x1EB7,0x1EA1,0x0306}, {0x1EB8,0x0045,0x0323}, {0x1EB9,0x0065,0x0323},
+    {0x1EBA,0x0045,0x0309}, {0x1EBB,0x0065,0x0309}, {0x1EBC,0x0045,0x0303}, {0x1EBD,0x0065,0x0303},
+    {0x1EBE,0x00CA,0x0301}, {0x1EBF,0x00EA,0x0301}, {0x1EC0,0x00CA,0x0300}, {0x1EC1,0x00EA,0x0300},
+    {0x1EC2,0x00CA,0x0309}, {0x1EC3,0x00EA,0x0309}, {0x1EC4,0x00CA,0x0303}, {0x1EC5,0x00EA,0x0303},
+    {0x1EC6,0x1EB8,0x0302}, {0x1EC7,0x1EB9,0x0302}, {0x1EC8,0x0049,0x0309}, {0x1EC9,0x0069,0x0309},
+    {0x1ECA,0x0049,0x0323}, {0x1ECB,0x0069,0x0323}, {0x1ECC,0x004F,0x0323}, {0x1ECD,0x006F,0x0323},
+    {0x1ECE,0x004F,0x0309}, {0x1ECF,0x006F,0x0309}, {0x1ED0,0x00D4,0x0301}, {0x1ED1,0x00F4,0x0301},
+    {0x1ED2,0x00D4,0x0300}, {0x1ED3,0x00F4,0x0300}, {0x1ED4,0x00D4,0x0309}, {0x1ED5,0x00F4,0x0309},
+    {0x1ED6,0x00D4,0x0303}, {0x1ED7,0x00F4,0x0303}, {0x1ED8,0x1ECC,0x0302}, {0x1ED9,0x1ECD,0x0302},
+    {0x1EDA,0x01A0,0x0301}, {0x1EDB,0x01A1,0x0301}, {0x1EDC,0x01A0,0x0300}, {0x1EDD,0x01A1,0x0300},
+    {0x1EDE,0x01A0,0x0309}, {0x1EDF,0x01A1,0x0309}, {0x1EE0,0x01A0,0x0303}, {0x1EE1,0x01A1,0x0303},
+    {0x1EE2,0x01A0,0x0323}, {0x1EE3,0x01A1,0x0323}, {0x1EE4,0x0055,0x0323}, {0x1EE5,0x0075,0x0323},
+    {0x1EE6,0x0055,0x0309}, {0x1EE7,0x0075,0x0309}, {0x1EE8,0x01AF,0x0301}, {0x1EE9,0x01B0,0x0301},
+    {0x1EEA,0x01AF,0x0300}, {0x1EEB,0x01B0,0x0300}, {0x1EEC,0x01AF,0x0309}, {0x1EED,0x01B0,0x0309},
+    {0x1EEE,0x01AF,0x0303}, {0x1EEF,0x01B0,0x0303}, {0x1EF0,0x01AF,0x0323}, {0x1EF1,0x01B0,0x0323},
+    {0x1EF2,0x0059,0x0300}, {0x1EF3,0x0079,0x0300}, {0x1EF4,0x0059,0x0323}, {0x1EF5,0x0079,0x0323},
+    {0x1EF6,0x0059,0x0309}, {0x1EF7,0x0079,0x0309}, {0x1EF8,0x0059,0x0303}, {0x1EF9,0x0079,0x0303},
+    {0x1F00,0x03B1,0x0313}, {0x1F01,0x03B1,0x0314}, {0x1F02,0x1F00,0x0300}, {0x1F03,0x1F01,0x0300},
+    {0x1F04,0x1F00,0x0301}, {0x1F05,0x1F01,0x0301}, {0x1F06,0x1F00,0x0342}, {0x1F07,0x1F01,0x0342},
+    {0x1F08,0x0391,0x0313}, {0x1F09,0x0391,0x0314}, {0x1F0A,0x1F08,0x0300}, {0x1F0B,0x1F09,0x0300},
+    {0x1F0C,0x1F08,0x0301}, {0x1F0D,0x1F09,0x0301}, {0x1F0E,0x1F08,0x0342}, {0x1F0F,0x1F09,0x0342},
+    {0x1F10,0x03B5,0x0313}, {0x1F11,0x03B5,0x0314}, {0x1F12,0x1F10,0x0300}, {0x1F13,0x1F11,0x0300},
+    {0x1F14,0x1F10,0x0301}, {0x1F15,0x1F11,0x0301}, {0x1F18,0x0395,0x0313}, {0x1F19,0x0395,0x0314},
+    {0x1F1A,0x1F18,0x0300}, {0x1F1B,0x1F19,0x0300}, {0x1F1C,0x1F18,0x0301}, {0x1F1D,0x1F19,0x0301},
+    {0x1F20,0x03B7,0x0313}, {0x1F21,0x03B7,0x0314}, {0x1F22,0x1F20,0x0300}, {0x1F23,0x1F21,0x0300},
+    {0x1F24,0x1F20,0x0301}, {0x1F25,0x1F21,0x0301}, {0x1F26,0x1F20,0x0342}, {0x1F27,0x1F21,0x0342},
+    {0x1F28,0x0397,0x0313}, {0x1F29,0x0397,0x0314}, {0x1F2A,0x1F28,0x0300}, {0x1F2B,0x1F29,0x0300},
+    {0x1F2C,0x1F28,0x0301}, {0x1F2D,0x1F29,0x0301}, {0x1F2E,0x1F28,0x0342}, {0x1F2F,0x1F29,0x0342},
+    {0x1F30,0x03B9,0x0313}, {0x1F31,0x03B9,0x0314}, {0x1F32,0x1F30,0x0300}, {0x1F33,0x1F31,0x0300},
+    {0x1F34,0x1F30,0x0301}, {0x1F35,0x1F31,0x0301}, {0x1F36,0x1F30,0x0342}, {0x1F37,0x1F31,0x0342},
+    {0x1F38,0x0399,0x0313}, {0x1F39,0x0399,0x0314}, {0x1F3A,0x1F38,0x0300}, {0x1F3B,0x1F39,0x0300},
+    {0x1F3C,0x1F38,0x0301}, {0x1F3D,0x1F39,0x0301}, {0x1F3E,0x1F38,0x0342}, {0x1F3F,0x1F39,0x0342},
+    {0x1F40,0x03BF,0x0313}, {0x1F41,0x03BF,0x0314}, {0x1F42,0x1F40,0x0300}, {0x1F43,0x1F41,0x0300},
+    {0x1F44,0x1F40,0x0301}, {0x1F45,0x1F41,0x0301}, {0x1F48,0x039F,0x0313}, {0x1F49,0x039F,0x0314},
+    {0x1F4A,0x1F48,0x0300}, {0x1F4B,0x1F49,0x0300}, {0x1F4C,0x1F48,0x0301}, {0x1F4D,0x1F49,0x0301},
+    {0x1F50,0x03C5,0x0313}, {0x1F51,0x03C5,0x0314}, {0x1F52,0x1F50,0x0300}, {0x1F53,0x1F51,0x0300},
+    {0x1F54,0x1F50,0x0301}, {0x1F55,0x1F51,0x0301}, {0x1F56,0x1F50,0x0342}, {0x1F57,0x1F51,0x0342},
+    {0x1F59,0x03A5,0x0314}, {0x1F5B,0x1F59,0x0300}, {0x1F5D,0x1F59,0x0301}, {0x1F5F,0x1F59,0x0342},
+    {0x1F60,0x03C9,0x0313}, {0x1F61,0x03C9,0x0314}, {0x1F62,0x1F60,0x0300}, {0x1F63,0x1F61,0x0300},
+    {0x1F64,0x1F60,0x0301}, {0x1F65,0x1F61,0x0301}, {0x1F66,0x1F60,0x0342}, {0x1F67,0x1F61,0x0342},
+    {0x1F68,0x03A9,0x0313}, {0x1F69,0x03A9,0x0314}, {0x1F6A,0x1F68,0x0300}, {0x1F6B,0x1F69,0x0300},
+    {0x1F6C,0x1F68,0x0301}, {0x1F6D,0x1F69,0x0301}, {0x1F6E,0x1F68,0x0342}, {0x1F6F,0x1F69,0x0342},
+    {0x1F70,0x03B1,0x0300}, {0x1F71,0x03AC,0x0000}, {0x1F72,0x03B5,0x0300}, {0x1F73,0x03AD,0x0000},
+    {0x1F74,0x03B7,0x0300}, {0x1F75,0x03AE,0x0000}, {0x1F76,0x03B9,0x0300}, {0x1F77,0x03AF,0x0000},
+    {0x1F78,0x03BF,0x0300}, {0x1F79,0x03CC,0x0000}, {0x1F7A,0x03C5,0x0300}, {0x1F7B,0x03CD,0x0000},
+    {0x1F7C,0x03C9,0x0300}, {0x1F7D,0x03CE,0x0000}, {0x1F80,0x1F00,0x0345}, {0x1F81,0x1F01,0x0345},
+    {0x1F82,0x1F02,0x0345}, {0x1F83,0x1F03,0x0345}, {0x1F84,0x1F04,0x0345}, {0x1F85,0x1F05,0x0345},
+    {0x1F86,0x1F06,0x0345}, {0x1F87,0x1F07,0x0345}, {0x1F88,0x1F08,0x0345}, {0x1F89,0x1F09,0x0345},
+    {0x1F8A,0x1F0A,0x0345}, {0x1F8B,0x1F0B,0x0345}, {0x1F8C,0x1F0C,0x0345}, {0x1F8D,0x1F0D,0x0345},
+    {0x1F8E,0x1F0E,0x0345}, {0x1F8F,0x1F0F,0x0345}, {0x1F90,0x1F20,0x0345}, {0x1F91,0x1F21,0x0345},
+    {0x1F92,0x1F22,0x0345}, {0x1F93,0x1F23,0x0345}, {0x1F94,0x1F24,0x0345}, {0x1F95,0x1F25,0x0345},
+    {0x1F96,0x1F26,0x0345}, {0x1F97,0x1F27,0x0345}, {0x1F98,0x1F28,0x0345}, {0x1F99,0x1F29,0x0345},
+    {0x1F9A,0x1F2A,0x0345}, {0x1F9B,0x1F2B,0x0345}, {0x1F9C,0x1F2C,0x0345}, {0x1F9D,0x1F2D,0x0345},
+    {0x1F9E,0x1F2E,0x0345}, {0x1F9F,0x1F2F,0x0345}, {0x1FA0,0x1F60,0x0345}, {0x1FA1,0x1F61,0x0345},
+    {0x1FA2,0x1F62,0x0345}, {0x1FA3,0x1F63,0x0345}, {0x1FA4,0x1F64,0x0345}, {0x1FA5,0x1F65,0x0345},
+    {0x1FA6,0x1F66,0x0345}, {0x1FA7,0x1F67,0x0345}, {0x1FA8,0x1F68,0x0345}, {0x1FA9,0x1F69,0x0345},
+    {0x1FAA,0x1F6A,0x0345}, {0x1FAB,0x1F6B,0x0345}, {0x1FAC,0x1F6C,0x0345}, {0x1FAD,0x1F6D,0x0345},
+    {0x1FAE,0x1F6E,0x0345}, {0x1FAF,0x1F6F,0x0345}, {0x1FB0,0x03B1,0x0306}, {0x1FB1,0x03B1,0x0304},
+    {0x1FB2,0x1F70,0x0345}, {0x1FB3,0x03B1,0x0345}, {0x1FB4,0x03AC,0x0345}, {0x1FB6,0x03B1,0x0342},
+    {0x1FB7,0x1FB6,0x0345}, {0x1FB8,0x0391,0x0306}, {0x1FB9,0x0391,0x0304}, {0x1FBA,0x0391,0x0300},
+    {0x1FBB,0x0386,0x0000}, {0x1FBC,0x0391,0x0345}, {0x1FBE,0x03B9,0x0000}, {0x1FC1,0x00A8,0x0342},
+    {0x1FC2,0x1F74,0x0345}, {0x1FC3,0x03B7,0x0345}, {0x1FC4,0x03AE,0x0345}, {0x1FC6,0x03B7,0x0342},
+    {0x1FC7,0x1FC6,0x0345}, {0x1FC8,0x0395,0x0300}, {0x1FC9,0x0388,0x0000}, {0x1FCA,0x0397,0x0300},
+    {0x1FCB,0x0389,0x0000}, {0x1FCC,0x0397,0x0345}, {0x1FCD,0x1FBF,0x0300}, {0x1FCE,0x1FBF,0x0301},
+    {0x1FCF,0x1FBF,0x0342}, {0x1FD0,0x03B9,0x0306}, {0x1FD1,0x03B9,0x0304}, {0x1FD2,0x03CA,0x0300},
+    {0x1FD3,0x0390,0x0000}, {0x1FD6,0x03B9,0x0342}, {0x1FD7,0x03CA,0x0342}, {0x1FD8,0x0399,0x0306},
+    {0x1FD9,0x0399,0x0304}, {0x1FDA,0x0399,0x0300}, {0x1FDB,0x038A,0x0000}, {0x1FDD,0x1FFE,0x0300},
+    {0x1FDE,0x1FFE,0x0301}, {0x1FDF,0x1FFE,0x0342}, {0x1FE0,0x03C5,0x0306}, {0x1FE1,0x03C5,0x0304},
+    {0x1FE2,0x03CB,0x0300}, {0x1FE3,0x03B0,0x0000}, {0x1FE4,0x03C1,0x0313}, {0x1FE5,0x03C1,0x0314},
+    {0x1FE6,0x03C5,0x0342}, {0x1FE7,0x03CB,0x0342}, {0x1FE8,0x03A5,0x0306}, {0x1FE9,0x03A5,0x0304},
+    {0x1FEA,0x03A5,0x0300}, {0x1FEB,0x038E,0x0000}, {0x1FEC,0x03A1,0x0314}, {0x1FED,0x00A8,0x0300},
+    {0x1FEE,0x0385,0x0000}, {0x1FEF,0x0060,0x0000}, {0x1FF2,0x1F7C,0x0345}, {0x1FF3,0x03C9,0x0345},
+    {0x1FF4,0x03CE,0x0345}, {0x1FF6,0x03C9,0x0342}, {0x1FF7,0x1FF6,0x0345}, {0x1FF8,0x039F,0x0300},
+    {0x1FF9,0x038C,0x0000}, {0x1FFA,0x03A9,0x0300}, {0x1FFB,0x038F,0x0000}, {0x1FFC,0x03A9,0x0345},
+    {0x1FFD,0x00B4,0x0000}, {0x2000,0x2002,0x0000}, {0x2001,0x2003,0x0000}, {0x2126,0x03A9,0x0000},
+    {0x212A,0x004B,0x0000}, {0x212B,0x00C5,0x0000}, {0x219A,0x2190,0x0338}, {0x219B,0x2192,0x0338},
+    {0x21AE,0x2194,0x0338}, {0x21CD,0x21D0,0x0338}, {0x21CE,0x21D4,0x0338}, {0x21CF,0x21D2,0x0338},
+    {0x2204,0x2203,0x0338}, {0x2209,0x2208,0x0338}, {0x220C,0x220B,0x0338}, {0x2224,0x2223,0x0338},
+    {0x2226,0x2225,0x0338}, {0x2241,0x223C,0x0338}, {0x2244,0x2243,0x0338}, {0x2247,0x2245,0x0338},
+    {0x2249,0x2248,0x0338}, {0x2260,0x003D,0x0338}, {0x2262,0x2261,0x0338}, {0x226D,0x224D,0x0338},
+    {0x226E,0x003C,0x0338}, {0x226F,0x003E,0x0338}, {0x2270,0x2264,0x0338}, {0x2271,0x2265,0x0338},
+    {0x2274,0x2272,0x0338}, {0x2275,0x2273,0x0338}, {0x2278,0x2276,0x0338}, {0x2279,0x2277,0x0338},
+    {0x2280,0x227A,0x0338}, {0x2281,0x227B,0x0338}, {0x2284,0x2282,0x0338}, {0x2285,0x2283,0x0338},
+    {0x2288,0x2286,0x0338}, {0x2289,0x2287,0x0338}, {0x22AC,0x22A2,0x0338}, {0x22AD,0x22A8,0x0338},
+    {0x22AE,0x22A9,0x0338}, {0x22AF,0x22AB,0x0338}, {0x22E0,0x227C,0x0338}, {0x22E1,0x227D,0x0338},
+    {0x22E2,0x2291,0x0338}, {0x22E3,0x2292,0x0338}, {0x22EA,0x22B2,0x0338}, {0x22EB,0x22B3,0x0338},
+    {0x22EC,0x22B4,0x0338}, {0x22ED,0x22B5,0x0338}, {0x2329,0x3008,0x0000}, {0x232A,0x3009,0x0000},
+    {0x2ADC,0x2ADD,0x0338}, {0x304C,0x304B,0x3099}, {0x304E,0x304D,0x3099}, {0x3050,0x304F,0x3099},
+    {0x3052,0x3051,0x3099}, {0x3054,0x3053,0x3099}, {0x3056,0x3055,0x3099}, {0x3058,0x3057,0x3099},
+    {0x305A,0x3059,0x3099}, {0x305C,0x305B,0x3099}, {0x305E,0x305D,0x3099}, {0x3060,0x305F,0x3099},
+    {0x3062,0x3061,0x3099}, {0x3065,0x3064,0x3099}, {0x3067,0x3066,0x3099}, {0x3069,0x3068,0x3099},
+    {0x3070,0x306F,0x3099}, {0x3071,0x306F,0x309A}, {0x3073,0x3072,0x3099}, {0x3074,0x3072,0x309A},
+    {0x3076,0x3075,0x3099}, {0x3077,0x3075,0x309A}, {0x3079,0x3078,0x3099}, {0x307A,0x3078,0x309A},
+    {0x307C,0x307B,0x3099}, {0x307D,0x307B,0x309A}, {0x3094,0x3046,0x3099}, {0x309E,0x309D,0x3099},
+    {0x30AC,0x30AB,0x3099}, {0x30AE,0x30AD,0x3099}, {0x30B0,0x30AF,0x3099}, {0x30B2,0x30B1,0x3099},
+    {0x30B4,0x30B3,0x3099}, {0x30B6,0x30B5,0x3099}, {0x30B8,0x30B7,0x3099}, {0x30BA,0x30B9,0x3099},
+    {0x30BC,0x30BB,0x3099}, {0x30BE,0x30BD,0x3099}, {0x30C0,0x30BF,0x3099}, {0x30C2,0x30C1,0x3099},
+    {0x30C5,0x30C4,0x3099}, {0x30C7,0x30C6,0x3099}, {0x30C9,0x30C8,0x3099}, {0x30D0,0x30CF,0x3099},
+    {0x30D1,0x30CF,0x309A}, {0x30D3,0x30D2,0x3099}, {0x30D4,0x30D2,0x309A}, {0x30D6,0x30D5,0x3099},
+    {0x30D7,0x30D5,0x309A}, {0x30D9,0x30D8,0x3099}, {0x30DA,0x30D8,0x309A}, {0x30DC,0x30DB,0x3099},
+    {0x30DD,0x30DB,0x309A}, {0x30F4,0x30A6,0x3099}, {0x30F7,0x30EF,0x3099}, {0x30F8,0x30F0,0x3099},
+    {0x30F9,0x30F1,0x3099}, {0x30FA,0x30F2,0x3099}, {0x30FE,0x30FD,0x3099}, {0xF900,0x8C48,0x0000},
+    {0xF901,0x66F4,0x0000}, {0xF902,0x8ECA,0x0000}, {0xF903,0x8CC8,0x0000}, {0xF904,0x6ED1,0x0000},
+    {0xF905,0x4E32,0x0000}, {0xF906,0x53E5,0x0000}, {0xF907,0x9F9C,0x0000}, {0xF908,0x9F9C,0x0000},
+    {0xF909,0x5951,0x0000}, {0xF90A,0x91D1,0x0000}, {0xF90B,0x5587,0x0000}, {0xF90C,0x5948,0x0000},
+    {0xF90D,0x61F6,0x0000}, {0xF90E,0x7669,0x0000}, {0xF90F,0x7F85,0x0000}, {0xF910,0x863F,0x0000},
+    {0xF911,0x87BA,0x0000}, {0xF912,0x88F8,0x0000}, {0xF913,0x908F,0x0000}, {0xF914,0x6A02,0x0000},
+    {0xF915,0x6D1B,0x0000}, {0xF916,0x70D9,0x0000}, {0xF917,0x73DE,0x0000}, {0xF918,0x843D,0x0000},
+    {0xF919,0x916A,0x0000}, {0xF91A,0x99F1,0x0000}, {0xF91B,0x4E82,0x0000}, {0xF91C,0x5375,0x0000},
+    {0xF91D,0x6B04,0x0000}, {0xF91E,0x721B,0x0000}, {0xF91F,0x862D,0x0000}, {0xF920,0x9E1E,0x0000},
+    {0xF921,0x5D50,0x0000}, {0xF922,0x6FEB,0x0000}, {0xF923,0x85CD,0x0000}, {0xF924,0x8964,0x0000},
+    {0xF925,0x62C9,0x0000}, {0xF926,0x81D8,0x0000}, {0xF927,0x881F,0x0000}, {0xF928,0x5ECA,0x0000},
+    {0xF929,0x6717,0x0000}, {0xF92A,0x6D6A,0x0000}, {0xF92B,0x72FC,0x0000}, {0xF92C,0x90CE,0x0000},
+    {0xF92D,0x4F86,0x0000}, {0xF92E,0x51B7,0x0000}, {0xF92F,0x52DE,0x0000}, {0xF930,0x64C4,0x0000},
+    {0xF931,0x6AD3,0x0000}, {0xF932,0x7210,0x0000}, {0xF933,0x76E7,0x0000}, {0xF934,0x8001,0x0000},
+    {0xF935,0x8606,0x0000}, {0xF936,0x865C,0x0000}, {0xF937,0x8DEF,0x0000}, {0xF938,0x9732,0x0000},
+    {0xF939,0x9B6F,0x0000}, {0xF93A,0x9DFA,0x0000}, {0xF93B,0x788C,0x0000}, {0xF93C,0x797F,0x0000},
+    {0xF93D,0x7DA0,0x0000}, {0xF93E,0x83C9,0x0000}, {0xF93F,0x9304,0x0000}, {0xF940,0x9E7F,0x0000},
+    {0xF941,0x8AD6,0x0000}, {0xF942,0x58DF,0x0000}, {0xF943,0x5F04,0x0000}, {0xF944,0x7C60,0x0000},
+    {0xF945,0x807E,0x0000}, {0xF946,0x7262,0x0000}, {0xF947,0x78CA,0x0000}, {0xF948,0x8CC2,0x0000},
+    {0xF949,0x96F7,0x0000}, {0xF94A,0x58D8,0x0000}, {0xF94B,0x5C62,0x0000}, {0xF94C,0x6A13,0x0000},
+    {0xF94D,0x6DDA,0x0000}, {0xF94E,0x6F0F,0x0000}, {0xF94F,0x7D2F,0x0000}, {0xF950,0x7E37,0x0000},
+    {0xF951,0x964B,0x0000}, {0xF952,0x52D2,0x0000}, {0xF953,0x808B,0x0000}, {0xF954,0x51DC,0x0000},
+    {0xF955,0x51CC,0x0000}, {0xF956,0x7A1C,0x0000}, {0xF957,0x7DBE,0x0000}, {0xF958,0x83F1,0x0000},
+    {0xF959,0x9675,0x0000}, {0xF95A,0x8B80,0x0000}, {0xF95B,0x62CF,0x0000}, {0xF95C,0x6A02,0x0000},
+    {0xF95D,0x8AFE,0x0000}, {0xF95E,0x4E39,0x0000}, {0xF95F,0x5BE7,0x0000}, {0xF960,0x6012,0x0000},
+    {0xF961,0x7387,0x0000}, {0xF962,0x7570,0x0000}, {0xF963,0x5317,0x0000}, {0xF964,0x78FB,0x0000},
+    {0xF965,0x4FBF,0x0000}, {0xF966,0x5FA9,0x0000}, {0xF967,0x4E0D,0x0000}, {0xF968,0x6CCC,0x0000},
+    {0xF969,0x6578,0x0000}, {0xF96A,0x7D22,0x0000}, {0xF96B,0x53C3,0x0000}, {0xF96C,0x585E,0x0000},
+    {0xF96D,0x7701,0x0000}, {0xF96E,0x8449,0x0000}, {0xF96F,0x8AAA,0x0000}, {0xF970,0x6BBA,0x0000},
+    {0xF971,0x8FB0,0x0000}, {0xF972,0x6C88,0x0000}, {0xF973,0x62FE,0x0000}, {0xF974,0x82E5,0x0000},
+    {0xF975,0x63A0,0x0000}, {0xF976,0x7565,0x0000}, {0xF977,0x4EAE,0x0000}, {0xF978,0x5169,0x0000},
+    {0xF979,0x51C9,0x0000}, {0xF97A,0x6881,0x0000}, {0xF97B,0x7CE7,0x0000}, {0xF97C,0x826F,0x0000},
+    {0xF97D,0x8AD2,0x0000}, {0xF97E,0x91CF,0x0000}, {0xF97F,0x52F5,0x0000}, {0xF980,0x5442,0x0000},
+    {0xF981,0x5973,0x0000}, {0xF982,0x5EEC,0x0000}, {0xF983,0x65C5,0x0000}, {0xF984,0x6FFE,0x0000},
+    {0xF985,0x792A,0x0000}, {0xF986,0x95AD,0x0000}, {0xF987,0x9A6A,0x0000}, {0xF988,0x9E97,0x0000},
+    {0xF989,0x9ECE,0x0000}, {0xF98A,0x529B,0x0000}, {0xF98B,0x66C6,0x0000}, {0xF98C,0x6B77,0x0000},
+    {0xF98D,0x8F62,0x0000}, {0xF98E,0x5E74,0x0000}, {0xF98F,0x6190,0x0000}, {0xF990,0x6200,0x0000},
+    {0xF991,0x649A,0x0000}, {0xF992,0x6F23,0x0000}, {0xF993,0x7149,0x0000}, {0xF994,0x7489,0x0000},
+    {0xF995,0x79CA,0x0000}, {0xF996,0x7DF4,0x0000}, {0xF997,0x806F,0x0000}, {0xF998,0x8F26,0x0000},
+    {0xF999,0x84EE,0x0000}, {0xF99A,0x9023,0x0000}, {0xF99B,0x934A,0x0000}, {0xF99C,0x5217,0x0000},
+    {0xF99D,0x52A3,0x0000}, {0xF99E,0x54BD,0x0000}, {0xF99F,0x70C8,0x0000}, {0xF9A0,0x88C2,0x0000},
+    {0xF9A1,0x8AAA,0x0000}, {0xF9A2,0x5EC9,0x0000}, {0xF9A3,0x5FF5,0x0000}, {0xF9A4,0x637B,0x0000},
+    {0xF9A5,0x6BAE,0x0000}, {0xF9A6,0x7C3E,0x0000}, {0xF9A7,0x7375,0x0000}, {0xF9A8,0x4EE4,0x0000},
+    {0xF9A9,0x56F9,0x0000}, {0xF9AA,0x5BE7,0x0000}, {0xF9AB,0x5DBA,0x0000}, {0xF9AC,0x601C,0x0000},
+    {0xF9AD,0x73B2,0x0000}, {0xF9AE,0x7469,0x0000}, {0xF9AF,0x7F9A,0x0000}, {0xF9B0,0x8046,0x0000},
+    {0xF9B1,0x9234,0x0000}, {0xF9B2,0x96F6,0x0000}, {0xF9B3,0x9748,0x0000}, {0xF9B4,0x9818,0x0000},
+    {0xF9B5,0x4F8B,0x0000}, {0xF9B6,0x79AE,0x0000}, {0xF9B7,0x91B4,0x0000}, {0xF9B8,0x96B8,0x0000},
+    {0xF9B9,0x60E1,0x0000}, {0xF9BA,0x4E86,0x0000}, {0xF9BB,0x50DA,0x0000}, {0xF9BC,0x5BEE,0x0000},
+    {0xF9BD,0x5C3F,0x0000}, {0xF9BE,0x6599,0x0000}, {0xF9BF,0x6A02,0x0000}, {0xF9C0,0x71CE,0x0000},
+    {0xF9C1,0x7642,0x0000}, {0xF9C2,0x84FC,0x0000}, {0xF9C3,0x907C,0x0000}, {0xF9C4,0x9F8D,0x0000},
+    {0xF9C5,0x6688,0x0000}, {0xF9C6,0x962E,0x0000}, {0xF9C7,0x5289,0x0000}, {0xF9C8,0x677B,0x0000},
+    {0xF9C9,0x67F3,0x0000}, {0xF9CA,0x6D41,0x0000}, {0xF9CB,0x6E9C,0x0000}, {0xF9CC,0x7409,0x0000},
+    {0xF9CD,0x7559,0x0000}, {0xF9CE,0x786B,0x0000}, {0xF9CF,0x7D10,0x0000}, {0xF9D0,0x985E,0x0000},
+    {0xF9D1,0x516D,0x0000}, {0xF9D2,0x622E,0x0000}, {0xF9D3,0x9678,0x0000}, {0xF9D4,0x502B,0x0000},
+    {0xF9D5,0x5D19,0x0000}, {0xF9D6,0x6DEA,0x0000}, {0xF9D7,0x8F2A,0x0000}, {0xF9D8,0x5F8B,0x0000},
+    {0xF9D9,0x6144,0x0000}, {0xF9DA,0x6817,0x0000}, {0xF9DB,0x7387,0x0000}, {0xF9DC,0x9686,0x0000},
+    {0xF9DD,0x5229,0x0000}, {0xF9DE,0x540F,0x0000}, {0xF9DF,0x5C65,0x0000}, {0xF9E0,0x6613,0x0000},
+    {0xF9E1,0x674E,0x0000}, {0xF9E2,0x68A8,0x0000}, {0xF9E3,0x6CE5,0x0000}, {0xF9E4,0x7406,0x0000},
+    {0xF9E5,0x75E2,0x0000}, {0xF9E6,0x7F79,0x0000}, {0xF9E7,0x88CF,0x0000}, {0xF9E8,0x88E1,0x0000},
+    {0xF9E9,0x91CC,0x0000}, {0xF9EA,0x96E2,0x0000}, {0xF9EB,0x533F,0x0000}, {0xF9EC,0x6EBA,0x0000},
+    {0xF9ED,0x541D,0x0000}, {0xF9EE,0x71D0,0x0000}, {0xF9EF,0x7498,0x0000}, {0xF9F0,0x85FA,0x0000},
+    {0xF9F1,0x96A3,0x0000}, {0xF9F2,0x9C57,0x0000}, {0xF9F3,0x9E9F,0x0000}, {0xF9F4,0x6797,0x0000},
+    {0xF9F5,0x6DCB,0x0000}, {0xF9F6,0x81E8,0x0000}, {0xF9F7,0x7ACB,0x0000}, {0xF9F8,0x7B20,0x0000},
+    {0xF9F9,0x7C92,0x0000}, {0xF9FA,0x72C0,0x0000}, {0xF9FB,0x7099,0x0000}, {0xF9FC,0x8B58,0x0000},
+    {0xF9FD,0x4EC0,0x0000}, {0xF9FE,0x8336,0x0000}, {0xF9FF,0x523A,0x0000}, {0xFA00,0x5207,0x0000},
+    {0xFA01,0x5EA6,0x0000}, {0xFA02,0x62D3,0x0000}, {0xFA03,0x7CD6,0x0000}, {0xFA04,0x5B85,0x0000},
+    {0xFA05,0x6D1E,0x0000}, {0xFA06,0x66B4,0x0000}, {0xFA07,0x8F3B,0x0000}, {0xFA08,0x884C,0x0000},
+    {0xFA09,0x964D,0x0000}, {0xFA0A,0x898B,0x0000}, {0xFA0B,0x5ED3,0x0000}, {0xFA0C,0x5140,0x0000},
+    {0xFA0D,0x55C0,0x0000}, {0xFA10,0x585A,0x0000}, {0xFA12,0x6674,0x0000}, {0xFA15,0x51DE,0x0000},
+    {0xFA16,0x732A,0x0000}, {0xFA17,0x76CA,0x0000}, {0xFA18,0x793C,0x0000}, {0xFA19,0x795E,0x0000},
+    {0xFA1A,0x7965,0x0000}, {0xFA1B,0x798F,0x0000}, {0xFA1C,0x9756,0x0000}, {0xFA1D,0x7CBE,0x0000},
+    {0xFA1E,0x7FBD,0x0000}, {0xFA20,0x8612,0x0000}, {0xFA22,0x8AF8,0x0000}, {0xFA25,0x9038,0x0000},
+    {0xFA26,0x90FD,0x0000}, {0xFA2A,0x98EF,0x0000}, {0xFA2B,0x98FC,0x0000}, {0xFA2C,0x9928,0x0000},
+    {0xFA2D,0x9DB4,0x0000}, {0xFA2E,0x90DE,0x0000}, {0xFA2F,0x96B7,0x0000}, {0xFA30,0x4FAE,0x0000},
+    {0xFA31,0x50E7,0x0000}, {0xFA32,0x514D,0x0000}, {0xFA33,0x52C9,0x0000}, {0xFA34,0x52E4,0x0000},
+    {0xFA35,0x5351,0x0000}, {0xFA36,0x559D,0x0000}, {0xFA37,0x5606,0x0000}, {0xFA38,0x5668,0x0000},
+    {0xFA39,0x5840,0x0000}, {0xFA3A,0x58A8,0x0000}, {0xFA3B,0x5C64,0x0000}, {0xFA3C,0x5C6E,0x0000},
+    {0xFA3D,0x6094,0x0000}, {0xFA3E,0x6168,0x0000}, {0xFA3F,0x618E,0x0000}, {0xFA40,0x61F2,0x0000},
+    {0xFA41,0x654F,0x0000}, {0xFA42,0x65E2,0x0000}, {0xFA43,0x6691,0x0000}, {0xFA44,0x6885,0x0000},
+    {0xFA45,0x6D77,0x0000}, {0xFA46,0x6E1A,0x0000}, {0xFA47,0x6F22,0x0000}, {0xFA48,0x716E,0x0000},
+    {0xFA49,0x722B,0x0000}, {0xFA4A,0x7422,0x0000}, {0xFA4B,0x7891,0x0000}, {0xFA4C,0x793E,0x0000},
+    {0xFA4D,0x7949,0x0000}, {0xFA4E,0x7948,0x0000}, {0xFA4F,0x7950,0x0000}, {0xFA50,0x7956,0x0000},
+    {0xFA51,0x795D,0x0000}, {0xFA52,0x798D,0x0000}, {0xFA53,0x798E,0x0000}, {0xFA54,0x7A40,0x0000},
+    {0xFA55,0x7A81,0x0000}, {0xFA56,0x7BC0,0x0000}, {0xFA57,0x7DF4,0x0000}, {0xFA58,0x7E09,0x0000},
+    {0xFA59,0x7E41,0x0000}, {0xFA5A,0x7F72,0x0000}, {0xFA5B,0x8005,0x0000}, {0xFA5C,0x81ED,0x0000},
+    {0xFA5D,0x8279,0x0000}, {0xFA5E,0x8279,0x0000}, {0xFA5F,0x8457,0x0000}, {0xFA60,0x8910,0x0000},
+    {0xFA61,0x8996,0x0000}, {0xFA62,0x8B01,0x0000}, {0xFA63,0x8B39,0x0000}, {0xFA64,0x8CD3,0x0000},
+    {0xFA65,0x8D08,0x0000}, {0xFA66,0x8FB6,0x0000}, {0xFA67,0x9038,0x0000}, {0xFA68,0x96E3,0x0000},
+    {0xFA69,0x97FF,0x0000}, {0xFA6A,0x983B,0x0000}, {0xFA6B,0x6075,0x0000}, {0xFA6C,0x242EE,0x0000},
+    {0xFA6D,0x8218,0x0000}, {0xFA70,0x4E26,0x0000}, {0xFA71,0x51B5,0x0000}, {0xFA72,0x5168,0x0000},
+    {0xFA73,0x4F80,0x0000}, {0xFA74,0x5145,0x0000}, {0xFA75,0x5180,0x0000}, {0xFA76,0x52C7,0x0000},
+    {0xFA77,0x52FA,0x0000}, {0xFA78,0x559D,0x0000}, {0xFA79,0x5555,0x0000}, {0xFA7A,0x5599,0x0000},
+    {0xFA7B,0x55E2,0x0000}, {0xFA7C,0x585A,0x0000}, {0xFA7D,0x58B3,0x0000}, {0xFA7E,0x5944,0x0000},
+    {0xFA7F,0x5954,0x0000}, {0xFA80,0x5A62,0x0000}, {0xFA81,0x5B28,0x0000}, {0xFA82,0x5ED2,0x0000},
+    {0xFA83,0x5ED9,0x0000}, {0xFA84,0x5F69,0x0000}, {0xFA85,0x5FAD,0x0000}, {0xFA86,0x60D8,0x0000},
+    {0xFA87,0x614E,0x0000}, {0xFA88,0x6108,0x0000}, {0xFA89,0x618E,0x0000}, {0xFA8A,0x6160,0x0000},
+    {0xFA8B,0x61F2,0x0000}, {0xFA8C,0x6234,0x0000}, {0xFA8D,0x63C4,0x0000}, {0xFA8E,0x641C,0x0000},
+    {0xFA8F,0x6452,0x0000}, {0xFA90,0x6556,0x0000}, {0xFA91,0x6674,0x0000}, {0xFA92,0x6717,0x0000},
+    {0xFA93,0x671B,0x0000}, {0xFA94,0x6756,0x0000}, {0xFA95,0x6B79,0x0000}, {0xFA96,0x6BBA,0x0000},
+    {0xFA97,0x6D41,0x0000}, {0xFA98,0x6EDB,0x0000}, {0xFA99,0x6ECB,0x0000}, {0xFA9A,0x6F22,0x0000},
+    {0xFA9B,0x701E,0x0000}, {0xFA9C,0x716E,0x0000}, {0xFA9D,0x77A7,0x0000}, {0xFA9E,0x7235,0x0000},
+    {0xFA9F,0x72AF,0x0000}, {0xFAA0,0x732A,0x0000}, {0xFAA1,0x7471,0x0000}, {0xFAA2,0x7506,0x0000},
+    {0xFAA3,0x753B,0x0000}, {0xFAA4,0x761D,0x0000}, {0xFAA5,0x761F,0x0000}, {0xFAA6,0x76CA,0x0000},
+    {0xFAA7,0x76DB,0x0000}, {0xFAA8,0x76F4,0x0000}, {0xFAA9,0x774A,0x0000}, {0xFAAA,0x7740,0x0000},
+    {0xFAAB,0x78CC,0x0000}, {0xFAAC,0x7AB1,0x0000}, {0xFAAD,0x7BC0,0x0000}, {0xFAAE,0x7C7B,0x0000},
+    {0xFAAF,0x7D5B,0x0000}, {0xFAB0,0x7DF4,0x0000}, {0xFAB1,0x7F3E,0x0000}, {0xFAB2,0x8005,0x0000},
+    {0xFAB3,0x8352,0x0000}, {0xFAB4,0x83EF,0x0000}, {0xFAB5,0x8779,0x0000}, {0xFAB6,0x8941,0x0000},
+    {0xFAB7,0x8986,0x0000}, {0xFAB8,0x8996,0x0000}, {0xFAB9,0x8ABF,0x0000}, {0xFABA,0x8AF8,0x0000},
+    {0xFABB,0x8ACB,0x0000}, {0xFABC,0x8B01,0x0000}, {0xFABD,0x8AFE,0x0000}, {0xFABE,0x8AED,0x0000},
+    {0xFABF,0x8B39,0x0000}, {0xFAC0,0x8B8A,0x0000}, {0xFAC1,0x8D08,0x0000}, {0xFAC2,0x8F38,0x0000},
+    {0xFAC3,0x9072,0x0000}, {0xFAC4,0x9199,0x0000}, {0xFAC5,0x9276,0x0000}, {0xFAC6,0x967C,0x0000},
+    {0xFAC7,0x96E3,0x0000}, {0xFAC8,0x9756,0x0000}, {0xFAC9,0x97DB,0x0000}, {0xFACA,0x97FF,0x0000},
+    {0xFACB,0x980B,0x0000}, {0xFACC,0x983B,0x0000}, {0xFACD,0x9B12,0x0000}, {0xFACE,0x9F9C,0x0000},
+    {0xFACF,0x2284A,0x0000}, {0xFAD0,0x22844,0x0000}, {0xFAD1,0x233D5,0x0000}, {0xFAD2,0x3B9D,0x0000},
+    {0xFAD3,0x4018,0x0000}, {0xFAD4,0x4039,0x0000}, {0xFAD5,0x25249,0x0000}, {0xFAD6,0x25CD0,0x0000},
+    {0xFAD7,0x27ED3,0x0000}, {0xFAD8,0x9F43,0x0000}, {0xFAD9,0x9F8E,0x0000}, {0xFB1D,0x05D9,0x05B4},
+    {0xFB1F,0x05F2,0x05B7}, {0xFB2A,0x05E9,0x05C1}, {0xFB2B,0x05E9,0x05C2}, {0xFB2C,0xFB49,0x05C1},
+    {0xFB2D,0xFB49,0x05C2}, {0xFB2E,0x05D0,0x05B7}, {0xFB2F,0x05D0,0x05B8}, {0xFB30,0x05D0,0x05BC},
+    {0xFB31,0x05D1,0x05BC}, {0xFB32,0x05D2,0x05BC}, {0xFB33,0x05D3,0x05BC}, {0xFB34,0x05D4,0x05BC},
+    {0xFB35,0x05D5,0x05BC}, {0xFB36,0x05D6,0x05BC}, {0xFB38,0x05D8,0x05BC}, {0xFB39,0x05D9,0x05BC},
+    {0xFB3A,0x05DA,0x05BC}, {0xFB3B,0x05DB,0x05BC}, {0xFB3C,0x05DC,0x05BC}, {0xFB3E,0x05DE,0x05BC},
+    {0xFB40,0x05E0,0x05BC}, {0xFB41,0x05E1,0x05BC}, {0xFB43,0x05E3,0x05BC}, {0xFB44,0x05E4,0x05BC},
+    {0xFB46,0x05E6,0x05BC}, {0xFB47,0x05E7,0x05BC}, {0xFB48,0x05E8,0x05BC}, {0xFB49,0x05E9,0x05BC},
+    {0xFB4A,0x05EA,0x05BC}, {0xFB4B,0x05D5,0x05B9}, {0xFB4C,0x05D1,0x05BF}, {0xFB4D,0x05DB,0x05BF},
+    {0xFB4E,0x05E4,0x05BF},
+};
+
+// First, last, combining class.
+uint16_t const UNICODE_COMBINING_CLASSES[][3] = {
+    {0x0300,0x0314,230}, {0x0315,0x0315,232}, {0x0316,0x0319,220}, {0x031A,0x031A,232},
+    {0x031B,0x031B,216}, {0x031C,0x0320,220}, {0x0321,0x0322,202}, {0x0323,0x0326,220},
+    {0x0327,0x0328,202}, {0x0329,0x0333,220}, {0x0334,0x0338,  1}, {0x0339,0x033C,220},
+    {0x033D,0x0344,230}, {0x0345,0x0345,240}, {0x0346,0x0346,230}, {0x0347,0x0349,220},
+    {0x034A,0x034C,230}, {0x034D,0x034E,220}, {0x0350,0x0352,230}, {0x0353,0x0356,220},
+    {0x0357,0x0357,230}, {0x0358,0x0358,232}, {0x0359,0x035A,220}, {0x035B,0x035B,230},
+    {0x035C,0x035C,233}, {0x035D,0x035E,234}, {0x035F,0x035F,233}, {0x0360,0x0361,234},
+    {0x0362,0x0362,233}, {0x0363,0x036F,230}, {0x0483,0x0487,230}, {0x0591,0x0591,220},
+    {0x0592,0x0595,230}, {0x0596,0x0596,220}, {0x0597,0x0599,230}, {0x059A,0x059A,222},
+    {0x059B,0x059B,220}, {0x059C,0x05A1,230}, {0x05A2,0x05A7,220}, {0x05A8,0x05A9,230},
+    {0x05AA,0x05AA,220}, {0x05AB,0x05AC,230}, {0x05AD,0x05AD,222}, {0x05AE,0x05AE,228},
+    {0x05AF,0x05AF,230}, {0x05B0,0x05B0, 10}, {0x05B1,0x05B1, 11}, {0x05B2,0x05B2, 12},
+    {0x05B3,0x05B3, 13}, {0x05B4,0x05B4, 14}, {0x05B5,0x05B5, 15}, {0x05B6,0x05B6, 16},
+    {0x05B7,0x05B7, 17}, {0x05B8,0x05B8, 18}, {0x05B9,0x05BA, 19}, {0x05BB,0x05BB, 20},
+    {0x05BC,0x05BC, 21}, {0x05BD,0x05BD, 22}, {0x05BF,0x05BF, 23}, {0x05C1,0x05C1, 24},
+    {0x05C2,0x05C2, 25}, {0x05C4,0x05C4,230}, {0x05C5,0x05C5,220}, {0x05C7,0x05C7, 18},
+    {0x0610,0x0617,230}, {0x0618,0x0618, 30}, {0x0619,0x0619, 31}, {0x061A,0x061A, 32},
+    {0x064B,0x064B, 27}, {0x064C,0x064C, 28}, {0x064D,0x064D, 29}, {0x064E,0x064E, 30},
+    {0x064F,0x064F, 31}, {0x0650,0x0650, 32}, {0x0651,0x0651, 33}, {0x0652,0x0652, 34},
+    {0x0653,0x0654,230}, {0x0655,0x0656,220}, {0x0657,0x065B,230}, {0x065C,0x065C,220},
+    {0x065D,0x065E,230}, {0x065F,0x065F,220}, {0x0670,0x0670, 35}, {0x06D6,0x06DC,230},
+    {0x06DF,0x06E2,230}, {0x06E3,0x06E3,220}, {0x06E4,0x06E4,230}, {0x06E7,0x06E8,230},
+    {0x06EA,0x06EA,220}, {0x06EB,0x06EC,230}, {0x06ED,0x06ED,220}, {0x0711,0x0711, 36},
+    {0x0730,0x0730,230}, {0x0731,0x0731,220}, {0x0732,0x0733,230}, {0x0734,0x0734,220},
+    {0x0735,0x0736,230}, {0x0737,0x0739,220}, {0x073A,0x073A,230}, {0x073B,0x073C,220},
+    {0x073D,0x073D,230}, {0x073E,0x073E,220}, {0x073F,0x0741,230}, {0x0742,0x0742,220},
+    {0x0743,0x0743,230}, {0x0744,0x0744,220}, {0x0745,0x0745,230}, {0x0746,0x0746,220},
+    {0x0747,0x0747,230}, {0x0748,0x0748,220}, {0x0749,0x074A,230}, {0x07EB,0x07F1,230},
+    {0x07F2,0x07F2,220}, {0x07F3,0x07F3,230}, {0x07FD,0x07FD,220}, {0x0816,0x0819,230},
+    {0x081B,0x0823,230}, {0x0825,0x0827,230}, {0x0829,0x082D,230}, {0x0859,0x085B,220},
+    {0x0898,0x0898,230}, {0x0899,0x089B,220}, {0x089C,0x089F,230}, {0x08CA,0x08CE,230},
+    {0x08CF,0x08D3,220}, {0x08D4,0x08E1,230}, {0x08E3,0x08E3,220}, {0x08E4,0x08E5,230},
+    {0x08E6,0x08E6,220}, {0x08E7,0x08E8,230}, {0x08E9,0x08E9,220}, {0x08EA,0x08EC,230},
+    {0x08ED,0x08EF,220}, {0x08F0,0x08F0, 27}, {0x08F1,0x08F1, 28}, {0x08F2,0x08F2, 29},
+    {0x08F3,0x08F5,230}, {0x08F6,0x08F6,220}, {0x08F7,0x08F8,230}, {0x08F9,0x08FA,220},
+    {0x08FB,0x08FF,230}, {0x093C,0x093C,  7}, {0x094D,0x094D,  9}, {0x0951,0x0951,230},
+    {0x0952,0x0952,220}, {0x0953,0x0954,230}, {0x09BC,0x09BC,  7}, {0x09CD,0x09CD,  9},
+    {0x09FE,0x09FE,230}, {0x0A3C,0x0A3C,  7}, {0x0A4D,0x0A4D,  9}, {0x0ABC,0x0ABC,  7},
+    {0x0ACD,0x0ACD,  9}, {0x0B3C,0x0B3C,  7}, {0x0B4D,0x0B4D,  9}, {0x0BCD,0x0BCD,  9},
+    {0x0C3C,0x0C3C,  7}, {0x0C4D,0x0C4D,  9}, {0x0C55,0x0C55, 84}, {0x0C56,0x0C56, 91},
+    {0x0CBC,0x0CBC,  7}, {0x0CCD,0x0CCD,  9}, {0x0D3B,0x0D3C,  9}, {0x0D4D,0x0D4D,  9},
+    {0x0DCA,0x0DCA,  9}, {0x0E38,0x0E39,103}, {0x0E3A,0x0E3A,  9}, {0x0E48,0x0E4B,107},
+    {0x0EB8,0x0EB9,118}, {0x0EBA,0x0EBA,  9}, {0x0EC8,0x0ECB,122}, {0x0F18,0x0F19,220},
+    {0x0F35,0x0F35,220}, {0x0F37,0x0F37,220}, {0x0F39,0x0F39,216}, {0x0F71,0x0F71,129},
+    {0x0F72,0x0F72,130}, {0x0F74,0x0F74,132}, {0x0F7A,0x0F7D,130}, {0x0F80,0x0F80,130},
+    {0x0F82,0x0F83,230}, {0x0F84,0x0F84,  9}, {0x0F86,0x0F87,230}, {0x0FC6,0x0FC6,220},
+    {0x1037,0x1037,  7}, {0x1039,0x103A,  9}, {0x108D,0x108D,220}, {0x135D,0x135F,230},
+    {0x1714,0x1715,  9}, {0x1734,0x1734,  9}, {0x17D2,0x17D2,  9}, {0x17DD,0x17DD,230},
+    {0x18A9,0x18A9,228}, {0x1939,0x1939,222}, {0x193A,0x193A,230}, {0x193B,0x193B,220},
+    {0x1A17,0x1A17,230}, {0x1A18,0x1A18,220}, {0x1A60,0x1A60,  9}, {0x1A75,0x1A7C,230},
+    {0x1A7F,0x1A7F,220}, {0x1AB0,0x1AB4,230}, {0x1AB5,0x1ABA,220}, {0x1ABB,0x1ABC,230},
+    {0x1ABD,0x1ABD,220}, {0x1ABF,0x1AC0,220}, {0x1AC1,0x1AC2,230}, {0x1AC3,0x1AC4,220},
+    {0x1AC5,0x1AC9,230}, {0x1ACA,0x1ACA,220}, {0x1ACB,0x1ACE,230}, {0x1B34,0x1B34,  7},
+    {0x1B44,0x1B44,  9}, {0x1B6B,0x1B6B,230}, {0x1B6C,0x1B6C,220}, {0x1B6D,0x1B73,230},
+    {0x1BAA,0x1BAB,  9}, {0x1BE6,0x1BE6,  7}, {0x1BF2,0x1BF3,  9}, {0x1C37,0x1C37,  7},
+    {0x1CD0,0x1CD2,230}, {0x1CD4,0x1CD4,  1}, {0x1CD5,0x1CD9,220}, {0x1CDA,0x1CDB,230},
+    {0x1CDC,0x1CDF,220}, {0x1CE0,0x1CE0,230}, {0x1CE2,0x1CE8,  1}, {0x1CED,0x1CED,220},
+    {0x1CF4,0x1CF4,230}, {0x1CF8,0x1CF9,230}, {0x1DC0,0x1DC1,230}, {0x1DC2,0x1DC2,220},
+    {0x1DC3,0x1DC9,230}, {0x1DCA,0x1DCA,220}, {0x1DCB,0x1DCC,230}, {0x1DCD,0x1DCD,234},
+    {0x1DCE,0x1DCE,214}, {0x1DCF,0x1DCF,220}, {0x1DD0,0x1DD0,202}, {0x1DD1,0x1DF5,230},
+    {0x1DF6,0x1DF6,232}, {0x1DF7,0x1DF8,228}, {0x1DF9,0x1DF9,220}, {0x1DFA,0x1DFA,218},
+    {0x1DFB,0x1DFB,230}, {0x1DFC,0x1DFC,233}, {0x1DFD,0x1DFD,220}, {0x1DFE,0x1DFE,230},
+    {0x1DFF,0x1DFF,220}, {0x20D0,0x20D1,230}, {0x20D2,0x20D3,  1}, {0x20D4,0x20D7,230},
+    {0x20D8,0x20DA,  1}, {0x20DB,0x20DC,230}, {0x20E1,0x20E1,230}, {0x20E5,0x20E6,  1},
+    {0x20E7,0x20E7,230}, {0x20E8,0x20E8,220}, {0x20E9,0x20E9,230}, {0x20EA,0x20EB,  1},
+    {0x20EC,0x20EF,220}, {0x20F0,0x20F0,230}, {0x2CEF,0x2CF1,230}, {0x2D7F,0x2D7F,  9},
+    {0x2DE0,0x2DFF,230}, {0x302A,0x302A,218}, {0x302B,0x302B,228}, {0x302C,0x302C,232},
+    {0x302D,0x302D,222}, {0x302E,0x302F,224}, {0x3099,0x309A,  8}, {0xA66F,0xA66F,230},
+    {0xA674,0xA67D,230}, {0xA69E,0xA69F,230}, {0xA6F0,0xA6F1,230}, {0xA806,0xA806,  9},
+    {0xA82C,0xA82C,  9}, {0xA8C4,0xA8C4,  9}, {0xA8E0,0xA8F1,230}, {0xA92B,0xA92D,220},
+    {0xA953,0xA953,  9}, {0xA9B3,0xA9B3,  7}, {0xA9C0,0xA9C0,  9}, {0xAAB0,0xAAB0,230},
+    {0xAAB2,0xAAB3,230}, {0xAAB4,0xAAB4,220}, {0xAAB7,0xAAB8,230}, {0xAABE,0xAABF,230},
+    {0xAAC1,0xAAC1,230}, {0xAAF6,0xAAF6,  9}, {0xABED,0xABED,  9}, {0xFB1E,0xFB1E, 26},
+    {0xFE20,0xFE26,230}, {0xFE27,0xFE2D,220}, {0xFE2E,0xFE2F,230},
+};
+
+// First, last, delta, stride.
+int32_t const UNICODE_CASE_FOLDS[][4] = {
+    {0x0041,0x005A,    32,1}, {0x00B5,0x00B5,   775,1}, {0x00C0,0x00D6,    32,1},
+    {0x00D8,0x00DE,    32,1}, {0x0100,0x012E,     1,2}, {0x0132,0x0136,     1,2},
+    {0x0139,0x0147,     1,2}, {0x014A,0x0176,     1,2}, {0x0178,0x0178,  -121,1},
+    {0x0179,0x017D,     1,2}, {0x017F,0x017F,  -268,1}, {0x0181,0x0181,   210,1},
+    {0x0182,0x0184,     1,2}, {0x0186,0x0186,   206,1}, {0x0187,0x0187,     1,1},
+    {0x0189,0x018A,   205,1}, {0x018B,0x018B,     1,1}, {0x018E,0x018E,    79,1},
+    {0x018F,0x018F,   202,1}, {0x0190,0x0190,   203,1}, {0x0191,0x0191,     1,1},
+    {0x0193,0x0193,   205,1}, {0x0194,0x0194,   207,1}, {0x0196,0x0196,   211,1},
+    {0x0197,0x0197,   209,1}, {0x0198,0x0198,     1,1}, {0x019C,0x019C,   211,1},
+    {0x019D,0x019D,   213,1}, {0x019F,0x019F,   214,1}, {0x01A0,0x01A4,     1,2},
+    {0x01A6,0x01A6,   218,1}, {0x01A7,0x01A7,     1,1}, {0x01A9,0x01A9,   218,1},
+    {0x01AC,0x01AC,     1,1}, {0x01AE,0x01AE,   218,1}, {0x01AF,0x01AF,     1,1},
+    {0x01B1,0x01B2,   217,1}, {0x01B3,0x01B5,     1,2}, {0x01B7,0x01B7,   219,1},
+    {0x01B8,0x01B8,     1,1}, {0x01BC,0x01BC,     1,1}, {0x01C4,0x01C4,     2,1},
+    {0x01C5,0x01C5,     1,1}, {0x01C7,0x01C7,     2,1}, {0x01C8,0x01C8,     1,1},
+    {0x01CA,0x01CA,     2,1}, {0x01CB,0x01DB,     1,2}, {0x01DE,0x01EE,     1,2},
+    {0x01F1,0x01F1,     2,1}, {0x01F2,0x01F4,     1,2}, {0x01F6,0x01F6,   -97,1},
+    {0x01F7,0x01F7,   -56,1}, {0x01F8,0x021E,     1,2}, {0x0220,0x0220,  -130,1},
+    {0x0222,0x0232,     1,2}, {0x023A,0x023A, 10795,1}, {0x023B,0x023B,     1,1},
+    {0x023D,0x023D,  -163,1}, {0x023E,0x023E, 10792,1}, {0x0241,0x0241,     1,1},
+    {0x0243,0x0243,  -195,1}, {0x0244,0x0244,    69,1}, {0x0245,0x0245,    71,1},
+    {0x0246,0x024E,     1,2}, {0x0345,0x0345,   116,1}, {0x0370,0x0372,     1,2},
+    {0x0376,0x0376,     1,1}, {0x037F,0x037F,   116,1}, {0x0386,0x0386,    38,1},
+    {0x0388,0x038A,    37,1}, {0x038C,0x038C,    64,1}, {0x038E,0x038F,    63,1},
+    {0x0391,0x03A1,    32,1}, {0x03A3,0x03AB,    32,1}, {0x03C2,0x03C2,     1,1},
+    {0x03CF,0x03CF,     8,1}, {0x03D0,0x03D0,   -30,1}, {0x03D1,0x03D1,   -25,1},
+    {0x03D5,0x03D5,   -15,1}, {0x03D6,0x03D6,   -22,1}, {0x03D8,0x03EE,     1,2},
+    {0x03F0,0x03F0,   -54,1}, {0x03F1,0x03F1,   -48,1}, {0x03F4,0x03F4,   -60,1},
+    {0x03F5,0x03F5,   -64,1}, {0x03F7,0x03F7,     1,1}, {0x03F9,0x03F9,    -7,1},
+    {0x03FA,0x03FA,     1,1}, {0x03FD,0x03FF,  -130,1}, {0x0400,0x040F,    80,1},
+    {0x0410,0x042F,    32,1}, {0x0460,0x0480,     1,2}, {0x048A,0x04BE,     1,2},
+    {0x04C0,0x04C0,    15,1}, {0x04C1,0x04CD,     1,2}, {0x04D0,0x052E,     1,2},
+    {0x0531,0x0556,    48,1}, {0x10A0,0x10C5,  7264,1}, {0x10C7,0x10C7,  7264,1},
+    {0x10CD,0x10CD,  7264,1}, {0x13F8,0x13FD,    -8,1}, {0x1C80,0x1C80, -6222,1},
+    {0x1C81,0x1C81, -6221,1}, {0x1C82,0x1C82, -6212,1}, {0x1C83,0x1C84, -6210,1},
+    {0x1C85,0x1C85, -6211,1}, {0x1C86,0x1C86, -6204,1}, {0x1C87,0x1C87, -6180,1},
+    {0x1C88,0x1C88, 35267,1}, {0x1C90,0x1CBA, -3008,1}, {0x1CBD,0x1CBF, -3008,1},
+    {0x1E00,0x1E94,     1,2}, {0x1E9B,0x1E9B,   -58,1}, {0x1EA0,0x1EFE,     1,2},
+    {0x1F08,0x1F0F,    -8,1}, {0x1F18,0x1F1D,    -8,1}, {0x1F28,0x1F2F,    -8,1},
+    {0x1F38,0x1F3F,    -8,1}, {0x1F48,0x1F4D,    -8,1}, {0x1F59,0x1F5F,    -8,2},
+    {0x1F68,0x1F6F,    -8,1}, {0x1FB8,0x1FB9,    -8,1}, {0x1FBA,0x1FBB,   -74,1},
+    {0x1FBE,0x1FBE, -7173,1}, {0x1FC8,0x1FCB,   -86,1}, {0x1FD8,0x1FD9,    -8,1},
+    {0x1FDA,0x1FDB,  -100,1}, {0x1FE8,0x1FE9,    -8,1}, {0x1FEA,0x1FEB,  -112,1},
+    {0x1FEC,0x1FEC,    -7,1}, {0x1FF8,0x1FF9,  -128,1}, {0x1FFA,0x1FFB,  -126,1},
+    {0x2126,0x2126, -7517,1}, {0x212A,0x212A, -8383,1}, {0x212B,0x212B, -8262,1},
+    {0x2132,0x2132,    28,1}, {0x2160,0x216F,    16,1}, {0x2183,0x2183,     1,1},
+    {0x24B6,0x24CF,    26,1}, {0x2C00,0x2C2F,    48,1}, {0x2C60,0x2C60,     1,1},
+    {0x2C62,0x2C62,-10743,1}, {0x2C63,0x2C63, -3814,1}, {0x2C64,0x2C64,-10727,1},
+    {0x2C67,0x2C6B,     1,2}, {0x2C6D,0x2C6D,-10780,1}, {0x2C6E,0x2C6E,-10749,1},
+    {0x2C6F,0x2C6F,-10783,1}, {0x2C70,0x2C70,-10782,1}, {0x2C72,0x2C72,     1,1},
+    {0x2C75,0x2C75,     1,1}, {0x2C7E,0x2C7F,-10815,1}, {0x2C80,0x2CE2,     1,2},
+    {0x2CEB,0x2CED,     1,2}, {0x2CF2,0x2CF2,     1,1}, {0xA640,0xA66C,     1,2},
+    {0xA680,0xA69A,     1,2}, {0xA722,0xA72E,     1,2}, {0xA732,0xA76E,     1,2},
+    {0xA779,0xA77B,     1,2}, {0xA77D,0xA77D,-35332,1}, {0xA77E,0xA786,     1,2},
+    {0xA78B,0xA78B,     1,1}, {0xA78D,0xA78D,-42280,1}, {0xA790,0xA792,     1,2},
+    {0xA796,0xA7A8,     1,2}, {0xA7AA,0xA7AA,-42308,1}, {0xA7AB,0xA7AB,-42319,1},
+    {0xA7AC,0xA7AC,-42315,1}, {0xA7AD,0xA7AD,-42305,1}, {0xA7AE,0xA7AE,-42308,1},
+    {0xA7B0,0xA7B0,-42258,1}, {0xA7B1,0xA7B1,-42282,1}, {0xA7B2,0xA7B2,-42261,1},
+    {0xA7B3,0xA7B3,   928,1}, {0xA7B4,0xA7C2,     1,2}, {0xA7C4,0xA7C4,   -48,1},
+    {0xA7C5,0xA7C5,-42307,1}, {0xA7C6,0xA7C6,-35384,1}, {0xA7C7,0xA7C9,     1,2},
+    {0xA7D0,0xA7D0,     1,1}, {0xA7D6,0xA7D8,     1,2}, {0xA7F5,0xA7F5,     1,1},
+    {0xAB70,0xABBF,-38864,1}, {0xFF21,0xFF3A,    32,1},
+};
+
+#endif